@@ -5,3 +5,6 @@ COMPONENT_DOXYGEN_INCLUDE_PATH := src/include/config.hpp
 COMPONENT_DOXYGEN_PREDEFINED := \
 	FSTR_INLINE= \
 	FSTR_PACKED=
+
+# Location of build tools for use by project makefiles
+FLASHSTRING_TOOLS := $(COMPONENT_PATH)/tools
@@ -0,0 +1,339 @@
+/****
+ * BinaryStream.cpp - Serialize objects as CBOR or MessagePack directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/BinaryStream.hpp"
+
+namespace
+{
+namespace Cbor
+{
+enum MajorType {
+	unsignedInt = 0,
+	negativeInt = 1,
+	bytes = 2,
+	text = 3,
+	array = 4,
+	map = 5,
+	tag = 6,
+};
+
+constexpr uint8_t falseValue{0xf4};
+constexpr uint8_t trueValue{0xf5};
+constexpr uint8_t nullValue{0xf6};
+constexpr uint8_t float32{0xfa};
+constexpr uint8_t float64{0xfb};
+
+} // namespace Cbor
+
+namespace MsgPack
+{
+constexpr uint8_t nil{0xc0};
+constexpr uint8_t falseValue{0xc2};
+constexpr uint8_t trueValue{0xc3};
+constexpr uint8_t bin8{0xc4};
+constexpr uint8_t bin16{0xc5};
+constexpr uint8_t bin32{0xc6};
+constexpr uint8_t float32{0xca};
+constexpr uint8_t float64{0xcb};
+constexpr uint8_t uint8{0xcc};
+constexpr uint8_t uint16{0xcd};
+constexpr uint8_t uint32{0xce};
+constexpr uint8_t uint64{0xcf};
+constexpr uint8_t int8{0xd0};
+constexpr uint8_t int16{0xd1};
+constexpr uint8_t int32{0xd2};
+constexpr uint8_t int64{0xd3};
+constexpr uint8_t str8{0xd9};
+constexpr uint8_t str16{0xda};
+constexpr uint8_t str32{0xdb};
+constexpr uint8_t array16{0xdc};
+constexpr uint8_t array32{0xdd};
+constexpr uint8_t map16{0xde};
+constexpr uint8_t map32{0xdf};
+constexpr uint8_t fixMap{0x80};
+constexpr uint8_t fixArray{0x90};
+constexpr uint8_t fixStr{0xa0};
+
+} // namespace MsgPack
+
+} // namespace
+
+namespace FSTR
+{
+using namespace Serialize;
+
+void BinaryGenerator::step()
+{
+	auto& frame = top();
+	auto& type = *frame.type;
+
+	// Strings and numeric arrays are copied directly from flash
+	if(type.kind == Kind::string || type.elementClass != ElementClass::other) {
+		size_t size = frame.length * type.elementSize;
+		if(frame.state == State::start) {
+			if(type.kind == Kind::string) {
+				emitHeader(Header::text, size);
+			} else {
+				emitTypedArrayHeader(type, size);
+			}
+			frame.state = State::next;
+		} else if(frame.index < size) {
+			emitContent(frame, size);
+		} else {
+			pop();
+		}
+		return;
+	}
+
+	bool isObject = (type.kind == Kind::object);
+
+	switch(frame.state) {
+	case State::start:
+		emitHeader(isObject ? Header::map : Header::array, frame.length);
+		frame.state = State::next;
+		break;
+
+	case State::next: {
+		if(frame.index >= frame.length) {
+			pop();
+			break;
+		}
+		Value key;
+		frame.type->getItem(frame.object, frame.index, frame.cursor, key, pending);
+		if(isObject) {
+			frame.state = State::value;
+			emitValue(key);
+		} else {
+			++frame.index;
+			emitValue(pending);
+		}
+		break;
+	}
+
+	case State::value:
+		++frame.index;
+		frame.state = State::next;
+		emitValue(pending);
+		break;
+	}
+}
+
+void BinaryGenerator::emitValue(const Value& value)
+{
+	if(value.type != Value::Type::object) {
+		emitScalar(value);
+	} else if(!push(value)) {
+		// Nested too deeply
+		emit(format == BinaryFormat::CBOR ? Cbor::nullValue : MsgPack::nil);
+	}
+}
+
+void BinaryGenerator::emitScalar(const Value& value)
+{
+	bool cbor = (format == BinaryFormat::CBOR);
+
+	switch(value.type) {
+	case Value::Type::boolean:
+		if(cbor) {
+			emit(value.boolean ? Cbor::trueValue : Cbor::falseValue);
+		} else {
+			emit(value.boolean ? MsgPack::trueValue : MsgPack::falseValue);
+		}
+		break;
+
+	case Value::Type::integer: {
+		auto n = value.integer;
+		if(cbor) {
+			if(value.negative) {
+				emitCborHeader(Cbor::negativeInt, n - 1);
+			} else {
+				emitCborHeader(Cbor::unsignedInt, n);
+			}
+		} else if(!value.negative) {
+			if(n <= 0x7f) {
+				emit(n);
+			} else if(n <= 0xff) {
+				emit(MsgPack::uint8);
+				emitBigEndian(n, 1);
+			} else if(n <= 0xffff) {
+				emit(MsgPack::uint16);
+				emitBigEndian(n, 2);
+			} else if(n <= 0xffffffff) {
+				emit(MsgPack::uint32);
+				emitBigEndian(n, 4);
+			} else {
+				emit(MsgPack::uint64);
+				emitBigEndian(n, 8);
+			}
+		} else {
+			// Two's complement representation
+			auto v = uint64_t(0) - n;
+			if(n <= 32) {
+				emit(v);
+			} else if(n <= 0x80) {
+				emit(MsgPack::int8);
+				emitBigEndian(v, 1);
+			} else if(n <= 0x8000) {
+				emit(MsgPack::int16);
+				emitBigEndian(v, 2);
+			} else if(n <= 0x80000000) {
+				emit(MsgPack::int32);
+				emitBigEndian(v, 4);
+			} else {
+				emit(MsgPack::int64);
+				emitBigEndian(v, 8);
+			}
+		}
+		break;
+	}
+
+	case Value::Type::real: {
+		float f = value.real;
+		if(double(f) == value.real || value.real != value.real) {
+			uint32_t bits;
+			memcpy(&bits, &f, sizeof(bits));
+			emit(cbor ? Cbor::float32 : MsgPack::float32);
+			emitBigEndian(bits, sizeof(bits));
+		} else {
+			uint64_t bits;
+			memcpy(&bits, &value.real, sizeof(bits));
+			emit(cbor ? Cbor::float64 : MsgPack::float64);
+			emitBigEndian(bits, sizeof(bits));
+		}
+		break;
+	}
+
+	case Value::Type::null:
+	default:
+		emit(cbor ? Cbor::nullValue : MsgPack::nil);
+	}
+}
+
+void BinaryGenerator::emitHeader(Header header, size_t length)
+{
+	if(format == BinaryFormat::CBOR) {
+		static constexpr uint8_t majorTypes[] = {Cbor::bytes, Cbor::text, Cbor::array, Cbor::map};
+		emitCborHeader(majorTypes[unsigned(header)], length);
+		return;
+	}
+
+	switch(header) {
+	case Header::bytes:
+		if(length <= 0xff) {
+			emit(MsgPack::bin8);
+			emitBigEndian(length, 1);
+		} else if(length <= 0xffff) {
+			emit(MsgPack::bin16);
+			emitBigEndian(length, 2);
+		} else {
+			emit(MsgPack::bin32);
+			emitBigEndian(length, 4);
+		}
+		break;
+
+	case Header::text:
+		if(length < 32) {
+			emit(MsgPack::fixStr | length);
+		} else if(length <= 0xff) {
+			emit(MsgPack::str8);
+			emitBigEndian(length, 1);
+		} else if(length <= 0xffff) {
+			emit(MsgPack::str16);
+			emitBigEndian(length, 2);
+		} else {
+			emit(MsgPack::str32);
+			emitBigEndian(length, 4);
+		}
+		break;
+
+	case Header::array:
+	case Header::map: {
+		bool isMap = (header == Header::map);
+		if(length < 16) {
+			emit((isMap ? MsgPack::fixMap : MsgPack::fixArray) | length);
+		} else if(length <= 0xffff) {
+			emit(isMap ? MsgPack::map16 : MsgPack::array16);
+			emitBigEndian(length, 2);
+		} else {
+			emit(isMap ? MsgPack::map32 : MsgPack::array32);
+			emitBigEndian(length, 4);
+		}
+		break;
+	}
+	}
+}
+
+void BinaryGenerator::emitTypedArrayHeader(const TypeInfo& type, size_t size)
+{
+	if(format == BinaryFormat::CBOR) {
+		/*
+		 * RFC 8746 tag is 0b010fsell
+		 *  f: floating-point
+		 *  s: signed integer
+		 *  e: little-endian (for 8-bit integers indicates clamped arithmetic so not set)
+		 *  ll: log2(size) for integers, size-1 for floats (16, 32, 64, 128 bits)
+		 */
+		uint8_t ll = (type.elementSize >= 8) ? 3 : (type.elementSize >= 4) ? 2 : (type.elementSize >= 2) ? 1 : 0;
+		uint8_t tag = 0x40;
+		if(type.elementClass == ElementClass::floatingPoint) {
+			tag |= 0x10 | (ll - 1);
+		} else {
+			tag |= ll;
+			if(type.elementClass == ElementClass::signedInt) {
+				tag |= 0x08;
+			}
+		}
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		if(type.elementSize > 1) {
+			tag |= 0x04;
+		}
+#endif
+		emitCborHeader(Cbor::tag, tag);
+	}
+	emitHeader(Header::bytes, size);
+}
+
+void BinaryGenerator::emitCborHeader(uint8_t majorType, uint64_t value)
+{
+	majorType <<= 5;
+	if(value < 24) {
+		emit(majorType | value);
+	} else if(value <= 0xff) {
+		emit(majorType | 24);
+		emitBigEndian(value, 1);
+	} else if(value <= 0xffff) {
+		emit(majorType | 25);
+		emitBigEndian(value, 2);
+	} else if(value <= 0xffffffff) {
+		emit(majorType | 26);
+		emitBigEndian(value, 4);
+	} else {
+		emit(majorType | 27);
+		emitBigEndian(value, 8);
+	}
+}
+
+void BinaryGenerator::emitBigEndian(uint64_t value, uint8_t size)
+{
+	while(size-- != 0) {
+		emit(uint8_t(value >> (size * 8)));
+	}
+}
+
+} // namespace FSTR
@@ -0,0 +1,100 @@
+/****
+ * BufferedStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/BufferedStream.hpp"
+#include <new>
+
+namespace FSTR
+{
+BufferedStream::BufferedStream(const ObjectBase& object, size_t bufferSize) : object(object)
+{
+	blockSize = std::max(ALIGNUP4(bufferSize / 2), sizeof(uint32_t));
+	buffer.reset(new(std::nothrow) uint32_t[blockSize / 2]);
+}
+
+const uint8_t* BufferedStream::getBlock(size_t block)
+{
+	auto index = block & 1;
+	auto ptr = slot(index);
+	if(blocks[index] != block) {
+		object.readFlash(block * blockSize, ptr, blockSize);
+		blocks[index] = block;
+		++readCount;
+	}
+	return ptr;
+}
+
+uint16_t BufferedStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(!buffer || bufSize <= 0) {
+		return 0;
+	}
+
+	auto len = object.length();
+	size_t count = std::min(size_t(bufSize), len - std::min(readPos, len));
+	size_t pos = readPos;
+	size_t copied = 0;
+	while(copied < count) {
+		auto block = pos / blockSize;
+		auto offset = pos % blockSize;
+		auto remain = count - copied;
+		if(offset == 0 && remain >= blockSize && blocks[block & 1] != block) {
+			// Read whole blocks directly
+			auto n = object.readFlash(pos, data + copied, remain - remain % blockSize);
+			++readCount;
+			copied += n;
+			pos += n;
+			continue;
+		}
+		auto ptr = getBlock(block);
+		auto n = std::min(blockSize - offset, remain);
+		memcpy(data + copied, ptr + offset, n);
+		copied += n;
+		pos += n;
+	}
+
+	return copied;
+}
+
+int BufferedStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = object.length() + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > object.length()) {
+		return -1;
+	}
+
+	readPos = newPos;
+	return readPos;
+}
+
+} // namespace FSTR
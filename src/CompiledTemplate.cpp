@@ -0,0 +1,161 @@
+/****
+ * CompiledTemplate.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/CompiledTemplate.hpp"
+#include <new>
+
+namespace FSTR
+{
+CompiledTemplateStream::CompiledTemplateStream(const CompiledTemplate& tmpl)
+	: tmpl(tmpl), fieldCount(tmpl.fields().length())
+{
+	auto varCount = tmpl.variables().length();
+	if(varCount != 0) {
+		values.reset(new(std::nothrow) WString[varCount]);
+	}
+}
+
+bool CompiledTemplateStream::setVar(int index, const WString& value)
+{
+	if(!values || index < 0 || unsigned(index) >= tmpl.variables().length()) {
+		return false;
+	}
+	values[index] = value;
+	totalLength = -1;
+	segment = 0;
+	segmentStart = 0;
+	return true;
+}
+
+const WString& CompiledTemplateStream::getVar(const char* name) const
+{
+	int index = tmpl.variables().indexOf(name, false);
+	return (values && index >= 0) ? values[index] : WString::empty;
+}
+
+size_t CompiledTemplateStream::textOffset(unsigned field) const
+{
+	return (field < fieldCount) ? tmpl.fields()[field].offset : tmpl.text().length();
+}
+
+size_t CompiledTemplateStream::segmentLength(unsigned segment) const
+{
+	auto field = segment / 2;
+	if(segment & 1) {
+		auto var = tmpl.fields()[field].variable;
+		return values ? values[var].length() : 0;
+	}
+	auto start = (field == 0) ? 0 : textOffset(field - 1);
+	return textOffset(field) - start;
+}
+
+size_t CompiledTemplateStream::readSegment(unsigned segment, size_t offset, char* data, size_t count) const
+{
+	auto field = segment / 2;
+	if(segment & 1) {
+		if(!values) {
+			return 0;
+		}
+		auto& value = values[tmpl.fields()[field].variable];
+		count = std::min(count, value.length() - offset);
+		memcpy(data, value.c_str() + offset, count);
+		return count;
+	}
+
+	auto start = (field == 0) ? 0 : textOffset(field - 1);
+	count = std::min(count, textOffset(field) - start - offset);
+	return tmpl.text().readFlash(start + offset, data, count);
+}
+
+int CompiledTemplateStream::available()
+{
+	if(totalLength < 0) {
+		size_t len = tmpl.text().length();
+		for(unsigned i = 0; i < fieldCount; ++i) {
+			len += segmentLength(i * 2 + 1);
+		}
+		totalLength = len;
+	}
+	return totalLength - int(readPos);
+}
+
+void CompiledTemplateStream::findSegment(size_t pos)
+{
+	if(pos < segmentStart) {
+		segment = 0;
+		segmentStart = 0;
+	}
+	unsigned segmentCount = fieldCount * 2 + 1;
+	while(segment + 1 < segmentCount) {
+		auto len = segmentLength(segment);
+		if(pos < segmentStart + len) {
+			break;
+		}
+		segmentStart += len;
+		++segment;
+	}
+}
+
+uint16_t CompiledTemplateStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(bufSize <= 0 || available() <= 0) {
+		return 0;
+	}
+
+	findSegment(readPos);
+	unsigned segmentCount = fieldCount * 2 + 1;
+	auto seg = segment;
+	size_t offset = readPos - segmentStart;
+	size_t copied = 0;
+	while(copied < size_t(bufSize) && seg < segmentCount) {
+		copied += readSegment(seg, offset, data + copied, bufSize - copied);
+		++seg;
+		offset = 0;
+	}
+
+	return copied;
+}
+
+int CompiledTemplateStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t length = readPos + available();
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = length + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > length) {
+		return -1;
+	}
+
+	readPos = newPos;
+	return readPos;
+}
+
+} // namespace FSTR
@@ -0,0 +1,52 @@
+/****
+ * FileMap.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/FileMap.hpp"
+
+namespace FSTR
+{
+const char* File::getETag(char* buffer) const
+{
+	auto value = etag();
+	auto p = buffer;
+	*p++ = '"';
+	for(int shift = 28; shift >= 0; shift -= 4) {
+		*p++ = "0123456789abcdef"[(value >> shift) & 0x0f];
+	}
+	*p++ = '"';
+	*p = '\0';
+	return buffer;
+}
+
+WString FileStream::id() const
+{
+	char buffer[11];
+	return file.getETag(buffer);
+}
+
+FileStream* FileMap::openIndex(int index) const
+{
+	auto& file = fileAt(index);
+	if(file.isNull()) {
+		return nullptr;
+	}
+	return new FileStream(file, pathAt(index));
+}
+
+} // namespace FSTR
@@ -0,0 +1,144 @@
+/****
+ * FrontCodedStringSet.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/FrontCodedStringSet.hpp"
+
+namespace FSTR
+{
+namespace
+{
+int compare(const char* s1, size_t len1, const char* s2, size_t len2)
+{
+	int cmp = memcmp(s1, s2, std::min(len1, len2));
+	if(cmp != 0) {
+		return cmp;
+	}
+	return int(len1) - int(len2);
+}
+
+} // namespace
+
+size_t FrontCodedStringSet::decode(unsigned index, size_t offset, char* buffer, uint8_t& length) const
+{
+	uint8_t hdr[2];
+	if(index % blockSize == 0) {
+		ObjectBase::read(offset++, hdr, 1);
+		length = hdr[0];
+		offset += ObjectBase::read(offset, buffer, length);
+	} else {
+		ObjectBase::read(offset, hdr, 2);
+		offset += 2;
+		length = hdr[0] + hdr[1];
+		offset += ObjectBase::read(offset, &buffer[hdr[0]], hdr[1]);
+	}
+	buffer[length] = '\0';
+	return offset;
+}
+
+int FrontCodedStringSet::compareHead(unsigned block, const char* key, size_t keyLength) const
+{
+	auto offset = blockOffset(block);
+	uint8_t len;
+	ObjectBase::read(offset++, &len, 1);
+	char buf[maxKeyLength];
+	ObjectBase::read(offset, buf, len);
+	return compare(buf, len, key, keyLength);
+}
+
+int FrontCodedStringSet::indexOf(const char* key, size_t keyLength) const
+{
+	if(keyLength > maxKeyLength) {
+		return -1;
+	}
+
+	// Locate last block whose head is <= key
+	int block = -1;
+	int lo = 0;
+	int hi = int(blockCount()) - 1;
+	while(lo <= hi) {
+		int mid = (lo + hi) / 2;
+		int cmp = compareHead(mid, key, keyLength);
+		if(cmp == 0) {
+			return mid * blockSize;
+		}
+		if(cmp < 0) {
+			block = mid;
+			lo = mid + 1;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	if(block < 0) {
+		return -1;
+	}
+
+	// Decode sequentially within the block
+	char buffer[maxKeyLength + 1];
+	unsigned index = block * blockSize;
+	auto end = std::min(index + blockSize, unsigned(length()));
+	size_t offset = blockOffset(block);
+	uint8_t len;
+	offset = decode(index, offset, buffer, len);
+	for(++index; index < end; ++index) {
+		offset = decode(index, offset, buffer, len);
+		int cmp = compare(buffer, len, key, keyLength);
+		if(cmp == 0) {
+			return index;
+		}
+		if(cmp > 0) {
+			break;
+		}
+	}
+
+	return -1;
+}
+
+size_t FrontCodedStringSet::valueAt(unsigned index, char* buffer) const
+{
+	if(index >= length()) {
+		buffer[0] = '\0';
+		return 0;
+	}
+
+	unsigned i = index - (index % blockSize);
+	size_t offset = blockOffset(i / blockSize);
+	uint8_t len;
+	for(; i <= index; ++i) {
+		offset = decode(i, offset, buffer, len);
+	}
+	return len;
+}
+
+size_t FrontCodedStringSet::printTo(Print& p) const
+{
+	size_t count = 0;
+
+	count += p.print('{');
+	for(auto it = begin(); it != end(); ++it) {
+		if(it.index() > 0) {
+			count += p.print(", ");
+		}
+		count += p.write(*it, it.length());
+	}
+	count += p.print('}');
+
+	return count;
+}
+
+} // namespace FSTR
@@ -0,0 +1,137 @@
+/****
+ * Gzip.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Gzip.hpp"
+#include "include/FlashString/InflateStream.hpp"
+#include "include/FlashString/Stream.hpp"
+
+namespace
+{
+// See RFC 1952
+constexpr uint8_t GZIP_ID1{0x1f};
+constexpr uint8_t GZIP_ID2{0x8b};
+constexpr uint8_t GZIP_CM_DEFLATE{8};
+constexpr uint8_t GZIP_FHCRC{0x02};
+constexpr uint8_t GZIP_FEXTRA{0x04};
+constexpr uint8_t GZIP_FNAME{0x08};
+constexpr uint8_t GZIP_FCOMMENT{0x10};
+constexpr size_t GZIP_HEADER_SIZE{10};
+constexpr size_t GZIP_TRAILER_SIZE{8};
+
+} // namespace
+
+namespace FSTR
+{
+bool GzipObject::parseHeader(size_t& offset, uint8_t& bits) const
+{
+	auto len = length();
+	if(len < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) {
+		return false;
+	}
+
+	uint8_t header[GZIP_HEADER_SIZE];
+	read(0, header, sizeof(header));
+	if(header[0] != GZIP_ID1 || header[1] != GZIP_ID2 || header[2] != GZIP_CM_DEFLATE) {
+		return false;
+	}
+
+	auto flags = header[3];
+	offset = GZIP_HEADER_SIZE;
+	bits = defaultWindowBits;
+
+	if(flags & GZIP_FEXTRA) {
+		uint8_t xlen[2];
+		read(offset, xlen, sizeof(xlen));
+		offset += sizeof(xlen);
+		size_t end = offset + xlen[0] + (xlen[1] << 8);
+		// Look for window size subfield
+		while(offset + 4 <= end) {
+			uint8_t sub[5];
+			read(offset, sub, sizeof(sub));
+			size_t sublen = sub[2] + (sub[3] << 8);
+			if(sub[0] == 'F' && sub[1] == 'W' && sublen == 1 && sub[4] >= 9 && sub[4] <= 15) {
+				bits = sub[4];
+			}
+			offset += 4 + sublen;
+		}
+		offset = end;
+	}
+
+	auto skipString = [&]() {
+		uint8_t c;
+		do {
+			if(read(offset++, &c, 1) == 0) {
+				return false;
+			}
+		} while(c != '\0');
+		return true;
+	};
+
+	if((flags & GZIP_FNAME) && !skipString()) {
+		return false;
+	}
+	if((flags & GZIP_FCOMMENT) && !skipString()) {
+		return false;
+	}
+	if(flags & GZIP_FHCRC) {
+		offset += 2;
+	}
+
+	return offset + GZIP_TRAILER_SIZE <= len;
+}
+
+bool GzipObject::isValid() const
+{
+	return payloadOffset() != 0;
+}
+
+size_t GzipObject::uncompressedLength() const
+{
+	auto len = length();
+	if(len < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) {
+		return 0;
+	}
+	uint8_t isize[4];
+	read(len - sizeof(isize), isize, sizeof(isize));
+	return isize[0] | (isize[1] << 8) | (isize[2] << 16) | (uint32_t(isize[3]) << 24);
+}
+
+size_t GzipObject::payloadOffset() const
+{
+	size_t offset;
+	uint8_t bits;
+	return parseHeader(offset, bits) ? offset : 0;
+}
+
+uint8_t GzipObject::windowBits() const
+{
+	size_t offset;
+	uint8_t bits;
+	return parseHeader(offset, bits) ? bits : defaultWindowBits;
+}
+
+IDataSourceStream* GzipObject::createStream(bool acceptGzip) const
+{
+	if(acceptGzip) {
+		return new Stream(*this);
+	}
+	return new InflateStream(*this);
+}
+
+} // namespace FSTR
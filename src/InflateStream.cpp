@@ -0,0 +1,440 @@
+/****
+ * InflateStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Decoder for DEFLATE format (RFC 1951) based on the approach used by `tinf`, adapted
+ * to decode incrementally into a circular buffer.
+ *
+ ****/
+
+#include "include/FlashString/InflateStream.hpp"
+#include <new>
+
+namespace
+{
+constexpr unsigned maxLiteralCodes{286};
+constexpr unsigned maxDistanceCodes{30};
+constexpr unsigned codeLengthCodes{19};
+
+// Base values and extra bits for length codes 257-285
+const uint16_t lengthBase[] PROGMEM = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+									   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t lengthBits[] PROGMEM = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+									  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+// Base values and extra bits for distance codes 0-29
+const uint16_t distanceBase[] PROGMEM = {1,	   2,	 3,	   4,	 5,	   7,	  9,	 13,	17,	   25,
+										 33,   49,	 65,   97,	 129,  193,	  257,	 385,	513,   769,
+										 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t distanceBits[] PROGMEM = {0, 0, 0, 0, 1, 1, 2, 2,	  3,  3,  4,  4,  5,  5,  6,
+										6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Order in which code length code lengths are stored
+const uint8_t codeLengthOrder[codeLengthCodes] PROGMEM = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+														  11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+} // namespace
+
+namespace FSTR
+{
+InflateStream::InflateStream(const GzipObject& object) : object(object)
+{
+	auto windowSize = 1U << object.windowBits();
+	window.reset(new(std::nothrow) uint8_t[windowSize]);
+	windowMask = windowSize - 1;
+	restart();
+}
+
+void InflateStream::restart()
+{
+	inPos = object.payloadOffset();
+	writePos = readPos = 0;
+	bitBuffer = 0;
+	bitCount = 0;
+	finalBlock = false;
+	storedLength = matchLength = matchDistance = 0;
+	inBufferPos = inBufferLength = 0;
+	state = (inPos == 0 || !window) ? State::error : State::blockHeader;
+}
+
+int InflateStream::readByte()
+{
+	if(inBufferPos == inBufferLength) {
+		inBufferLength = object.read(inPos, inBuffer, sizeof(inBuffer));
+		if(inBufferLength == 0) {
+			return -1;
+		}
+		inPos += inBufferLength;
+		inBufferPos = 0;
+	}
+	return inBuffer[inBufferPos++];
+}
+
+int InflateStream::readBits(unsigned count)
+{
+	while(bitCount < count) {
+		int c = readByte();
+		if(c < 0) {
+			return -1;
+		}
+		bitBuffer |= uint32_t(c) << bitCount;
+		bitCount += 8;
+	}
+	int value = bitBuffer & ((1U << count) - 1);
+	bitBuffer >>= count;
+	bitCount -= count;
+	return value;
+}
+
+template <size_t Symbols> bool InflateStream::buildTree(Tree<Symbols>& tree, const uint8_t* lengths, unsigned count)
+{
+	if(count > Symbols) {
+		return false;
+	}
+
+	memset(tree.counts, 0, sizeof(tree.counts));
+	for(unsigned i = 0; i < count; ++i) {
+		++tree.counts[lengths[i]];
+	}
+	tree.counts[0] = 0;
+
+	uint16_t offsets[16];
+	unsigned sum = 0;
+	int left = 1;
+	for(unsigned i = 0; i < 16; ++i) {
+		offsets[i] = sum;
+		sum += tree.counts[i];
+		// Check code is not over-subscribed
+		left = (left << 1) - tree.counts[i];
+		if(left < 0) {
+			return false;
+		}
+	}
+
+	for(unsigned i = 0; i < count; ++i) {
+		if(lengths[i] != 0) {
+			tree.symbols[offsets[lengths[i]]++] = i;
+		}
+	}
+
+	return true;
+}
+
+template <size_t Symbols> int InflateStream::decodeSymbol(const Tree<Symbols>& tree)
+{
+	int sum = 0;
+	int cur = 0;
+	unsigned len = 0;
+	do {
+		int bit = readBits(1);
+		if(bit < 0 || ++len >= 16) {
+			return -1;
+		}
+		cur = (cur << 1) + bit;
+		sum += tree.counts[len];
+		cur -= tree.counts[len];
+	} while(cur >= 0);
+
+	return tree.symbols[sum + cur];
+}
+
+void InflateStream::buildFixedTrees()
+{
+	uint8_t lengths[288];
+	memset(&lengths[0], 8, 144);
+	memset(&lengths[144], 9, 112);
+	memset(&lengths[256], 7, 24);
+	memset(&lengths[280], 8, 8);
+	buildTree(literalTree, lengths, 288);
+
+	memset(lengths, 5, maxDistanceCodes);
+	buildTree(distanceTree, lengths, maxDistanceCodes);
+}
+
+bool InflateStream::readDynamicTrees()
+{
+	int hlit = readBits(5);
+	int hdist = readBits(5);
+	int hclen = readBits(4);
+	if(hlit < 0 || hdist < 0 || hclen < 0) {
+		return false;
+	}
+	hlit += 257;
+	hdist += 1;
+	hclen += 4;
+	if(unsigned(hlit) > maxLiteralCodes || unsigned(hdist) > maxDistanceCodes) {
+		return false;
+	}
+
+	uint8_t lengths[maxLiteralCodes + maxDistanceCodes]{};
+
+	// Code length tree is built temporarily using the distance tree storage
+	for(int i = 0; i < hclen; ++i) {
+		int len = readBits(3);
+		if(len < 0) {
+			return false;
+		}
+		lengths[pgm_read_byte(&codeLengthOrder[i])] = len;
+	}
+	if(!buildTree(distanceTree, lengths, codeLengthCodes)) {
+		return false;
+	}
+
+	int total = hlit + hdist;
+	for(int num = 0; num < total;) {
+		int sym = decodeSymbol(distanceTree);
+		if(sym < 0) {
+			return false;
+		}
+		if(sym < 16) {
+			lengths[num++] = sym;
+			continue;
+		}
+
+		uint8_t value = 0;
+		int repeat;
+		switch(sym) {
+		case 16:
+			if(num == 0) {
+				return false;
+			}
+			value = lengths[num - 1];
+			repeat = readBits(2) + 3;
+			break;
+		case 17:
+			repeat = readBits(3) + 3;
+			break;
+		default:
+			repeat = readBits(7) + 11;
+		}
+		if(repeat < 3 || num + repeat > total) {
+			return false;
+		}
+		while(repeat-- > 0) {
+			lengths[num++] = value;
+		}
+	}
+
+	// End-of-block code must be present
+	if(lengths[256] == 0) {
+		return false;
+	}
+
+	return buildTree(literalTree, lengths, hlit) && buildTree(distanceTree, lengths + hlit, hdist);
+}
+
+bool InflateStream::readBlockHeader()
+{
+	int final = readBits(1);
+	int type = readBits(2);
+	if(final < 0 || type < 0) {
+		return false;
+	}
+	finalBlock = final;
+
+	switch(type) {
+	case 0: {
+		// Stored block starts on byte boundary
+		bitBuffer = 0;
+		bitCount = 0;
+		uint8_t hdr[4];
+		for(auto& c : hdr) {
+			int b = readByte();
+			if(b < 0) {
+				return false;
+			}
+			c = b;
+		}
+		storedLength = hdr[0] | (hdr[1] << 8);
+		uint16_t check = hdr[2] | (hdr[3] << 8);
+		if(storedLength != uint16_t(~check)) {
+			return false;
+		}
+		state = State::stored;
+		return true;
+	}
+
+	case 1:
+		buildFixedTrees();
+		state = State::huffman;
+		return true;
+
+	case 2:
+		if(!readDynamicTrees()) {
+			return false;
+		}
+		state = State::huffman;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+/*
+ * Decode until the required number of bytes are available, or the end of the data is reached.
+ * Pending data must never exceed the window size or it would be overwritten.
+ */
+void InflateStream::decode(size_t required)
+{
+	size_t windowSize = windowMask + 1;
+	if(required > windowSize) {
+		required = windowSize;
+	}
+
+	while(pending() < required) {
+		switch(state) {
+		case State::blockHeader:
+			if(finalBlock) {
+				state = State::done;
+			} else if(!readBlockHeader()) {
+				state = State::error;
+			}
+			break;
+
+		case State::stored: {
+			if(storedLength == 0) {
+				state = State::blockHeader;
+				break;
+			}
+			int c = readByte();
+			if(c < 0) {
+				state = State::error;
+				break;
+			}
+			put(c);
+			--storedLength;
+			break;
+		}
+
+		case State::huffman: {
+			if(matchLength != 0) {
+				put(window[(writePos - matchDistance) & windowMask]);
+				--matchLength;
+				break;
+			}
+
+			int sym = decodeSymbol(literalTree);
+			if(sym < 0) {
+				state = State::error;
+				break;
+			}
+			if(sym < 256) {
+				put(sym);
+				break;
+			}
+			if(sym == 256) {
+				state = State::blockHeader;
+				break;
+			}
+
+			sym -= 257;
+			if(sym >= 29) {
+				state = State::error;
+				break;
+			}
+			int lenExtra = readBits(pgm_read_byte(&lengthBits[sym]));
+			int dsym = decodeSymbol(distanceTree);
+			if(lenExtra < 0 || dsym < 0 || unsigned(dsym) >= maxDistanceCodes) {
+				state = State::error;
+				break;
+			}
+			int distExtra = readBits(pgm_read_byte(&distanceBits[dsym]));
+			if(distExtra < 0) {
+				state = State::error;
+				break;
+			}
+			size_t distance = pgm_read_word(&distanceBase[dsym]) + distExtra;
+			if(distance > writePos || distance > windowSize) {
+				// Data compressed using a larger window than declared
+				state = State::error;
+				break;
+			}
+			matchLength = pgm_read_word(&lengthBase[sym]) + lenExtra;
+			matchDistance = distance;
+			break;
+		}
+
+		case State::done:
+		case State::error:
+		default:
+			return;
+		}
+	}
+}
+
+uint16_t InflateStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(!isValid() || bufSize <= 0) {
+		return 0;
+	}
+
+	decode(bufSize);
+	size_t count = std::min(pending(), size_t(bufSize));
+	size_t pos = readPos & windowMask;
+	size_t len1 = std::min(count, windowMask + 1 - pos);
+	memcpy(data, &window[pos], len1);
+	memcpy(data + len1, &window[0], count - len1);
+	return count;
+}
+
+int InflateStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t length = object.uncompressedLength();
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = length + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > length) {
+		return -1;
+	}
+
+	if(newPos < readPos) {
+		// Data still in the window can be re-read, otherwise start again
+		size_t windowSize = windowMask + 1;
+		if(writePos - newPos <= windowSize) {
+			readPos = newPos;
+			return readPos;
+		}
+		restart();
+	}
+
+	// Decode and discard data up to the requested position
+	while(readPos < newPos) {
+		decode(newPos - readPos);
+		size_t count = std::min(pending(), newPos - readPos);
+		if(count == 0) {
+			state = State::error;
+			return -1;
+		}
+		readPos += count;
+	}
+
+	return readPos;
+}
+
+} // namespace FSTR
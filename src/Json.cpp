@@ -0,0 +1,227 @@
+/****
+ * Json.cpp - Serialize objects as JSON directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Json.hpp"
+#include <stringutil.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+/*
+ * Get escape sequence for a character
+ * @retval char Character to follow '\', 'u' for \u00XX form, 0 if no escaping required
+ */
+char escape(uint8_t c)
+{
+	switch(c) {
+	case '"':
+		return '"';
+	case '\\':
+		return '\\';
+	case '\b':
+		return 'b';
+	case '\f':
+		return 'f';
+	case '\n':
+		return 'n';
+	case '\r':
+		return 'r';
+	case '\t':
+		return 't';
+	default:
+		return (c < 0x20) ? 'u' : '\0';
+	}
+}
+
+/*
+ * Check text converts back to the same value, at the precision of its source type
+ */
+bool readsBack(const char* text, const FSTR::Serialize::Value& value)
+{
+	double check = strtod(text, nullptr);
+	if(value.digits <= std::numeric_limits<float>::digits10) {
+		return float(check) == float(value.real);
+	}
+	return check == value.real;
+}
+
+} // namespace
+
+namespace FSTR
+{
+using namespace Serialize;
+
+void JsonGenerator::step()
+{
+	auto& frame = top();
+	auto kind = frame.type->kind;
+
+	if(kind == Kind::string) {
+		stepString(frame);
+		return;
+	}
+
+	bool isObject = (kind == Kind::object);
+
+	switch(frame.state) {
+	case State::start:
+		emit(isObject ? '{' : '[');
+		frame.state = State::next;
+		break;
+
+	case State::next: {
+		if(frame.index >= frame.length) {
+			emit(isObject ? '}' : ']');
+			pop();
+			break;
+		}
+		if(frame.index != 0) {
+			emit(',');
+		}
+		Value key;
+		frame.type->getItem(frame.object, frame.index, frame.cursor, key, pending);
+		if(!isObject) {
+			++frame.index;
+			emitValue(pending);
+			break;
+		}
+		frame.state = State::value;
+		if(key.type == Value::Type::object) {
+			emitValue(key);
+		} else {
+			// Scalar keys must be quoted
+			emit('"');
+			emitScalar(key);
+			emit('"');
+		}
+		break;
+	}
+
+	case State::value:
+		emit(':');
+		++frame.index;
+		frame.state = State::next;
+		emitValue(pending);
+		break;
+	}
+}
+
+void JsonGenerator::stepString(Frame& frame)
+{
+	if(frame.state == State::start) {
+		emit('"');
+		frame.state = State::next;
+		return;
+	}
+
+	if(frame.index >= frame.length) {
+		emit('"');
+		pop();
+		return;
+	}
+
+	// Escaping is rare, so read enough to fill the text buffer and stop when it's full
+	uint8_t chunk[sizeof(text)];
+	auto object = static_cast<const ObjectBase*>(frame.object);
+	auto len = object->readFlash(frame.index, chunk, std::min(sizeof(chunk), size_t(frame.length - frame.index)));
+	size_t count = 0;
+	for(; count < len && space() >= 6; ++count) {
+		auto c = chunk[count];
+		auto esc = escape(c);
+		if(esc == '\0') {
+			emit(c);
+		} else if(esc == 'u') {
+			emit("\\u00", 4);
+			emit(hexchar(c >> 4));
+			emit(hexchar(c & 0x0f));
+		} else {
+			emit('\\');
+			emit(esc);
+		}
+	}
+	frame.index += count;
+}
+
+void JsonGenerator::emitValue(const Value& value)
+{
+	if(value.type != Value::Type::object) {
+		emitScalar(value);
+	} else if(!push(value)) {
+		// Nested too deeply
+		emit("null", 4);
+	}
+}
+
+void JsonGenerator::emitScalar(const Value& value)
+{
+	switch(value.type) {
+	case Value::Type::boolean:
+		value.boolean ? emit("true", 4) : emit("false", 5);
+		break;
+
+	case Value::Type::integer: {
+		char buf[21];
+		char* ptr = &buf[sizeof(buf)];
+		auto n = value.integer;
+		do {
+			*--ptr = '0' + (n % 10);
+			n /= 10;
+		} while(n != 0);
+		if(value.negative) {
+			*--ptr = '-';
+		}
+		emit(ptr, &buf[sizeof(buf)] - ptr);
+		break;
+	}
+
+	case Value::Type::real: {
+		if(!std::isfinite(value.real)) {
+			emit("null", 4);
+			break;
+		}
+		/*
+		 * Use the shortest representation which reads back as the same value.
+		 * Long enough for "-1.2345678901234567e-308".
+		 */
+		char buf[32];
+		int len;
+		unsigned digits = value.digits;
+		do {
+			len = snprintf(buf, sizeof(buf), "%.*g", digits++, value.real);
+		} while(!readsBack(buf, value) && digits <= value.digits + 3U);
+		emit(buf, len);
+		break;
+	}
+
+	case Value::Type::null:
+	default:
+		emit("null", 4);
+	}
+}
+
+size_t JsonPrinter::printTo(Print& p) const
+{
+	JsonGenerator gen(generator);
+	gen.restart();
+	return gen.printTo(p);
+}
+
+} // namespace FSTR
@@ -0,0 +1,126 @@
+/****
+ * MultiStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/MultiStream.hpp"
+#include <new>
+
+namespace FSTR
+{
+MultiStream::MultiStream(std::initializer_list<const ObjectBase*> objects)
+{
+	if(init(objects.size())) {
+		unsigned i = 0;
+		for(auto obj : objects) {
+			add(i++, obj ? *obj : String::empty());
+		}
+	}
+}
+
+bool MultiStream::init(unsigned count)
+{
+	fragments.reset(new(std::nothrow) Fragment[count]);
+	if(!fragments) {
+		return false;
+	}
+	this->count = count;
+	return true;
+}
+
+unsigned MultiStream::findFragment(size_t pos) const
+{
+	if(pos >= totalLength) {
+		return count;
+	}
+
+	// Find last fragment starting at or before pos, skipping empty fragments
+	unsigned first = 0;
+	unsigned n = count;
+	while(n > 0) {
+		auto step = n / 2;
+		auto mid = first + step;
+		if(fragments[mid].offset <= pos) {
+			first = mid + 1;
+			n -= step + 1;
+		} else {
+			n = step;
+		}
+	}
+	return first - 1;
+}
+
+uint16_t MultiStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(bufSize <= 0 || readPos >= totalLength) {
+		return 0;
+	}
+
+	size_t copied = 0;
+	auto pos = readPos;
+	auto index = current;
+	while(copied < size_t(bufSize) && index < count) {
+		auto& frag = fragments[index];
+		auto n = frag.object->readFlash(pos - frag.offset, data + copied, bufSize - copied);
+		copied += n;
+		pos += n;
+		if(pos >= frag.offset + frag.object->length()) {
+			++index;
+		}
+	}
+
+	return copied;
+}
+
+int MultiStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = totalLength + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > totalLength) {
+		return -1;
+	}
+
+	// Sequential reads usually stay within the current or next fragment
+	auto inFragment = [&](unsigned i) {
+		if(i >= count) {
+			return false;
+		}
+		auto& frag = fragments[i];
+		return newPos >= frag.offset && newPos < frag.offset + frag.object->length();
+	};
+	if(!inFragment(current)) {
+		current = inFragment(current + 1) ? current + 1 : findFragment(newPos);
+	}
+
+	readPos = newPos;
+	return readPos;
+}
+
+} // namespace FSTR
@@ -29,10 +29,10 @@ bool ObjectBase::operator==(const ObjectBase& other) const
 	if(this == &other) {
 		return true;
 	}
-	if(length() != other.length()) {
+	if(isNull() != other.isNull() || length() != other.length()) {
 		return false;
 	}
-	return memcmp(this, &other, sizeof(flashLength_) + size()) == 0;
+	return memcmp(data(), other.data(), size()) == 0;
 }
 
 size_t ObjectBase::readFlash(size_t offset, void* buffer, size_t count) const
@@ -59,6 +59,78 @@ size_t ObjectBase::read(size_t offset, void* buffer, size_t count) const
 	return count;
 }
 
+const uint8_t* ObjectBase::getDirectBuffer(size_t offset, size_t maxLen, size_t& length) const
+{
+#if FSTR_DIRECT_ACCESS
+	auto len = this->length();
+	if(isNull() || offset >= len) {
+		return nullptr;
+	}
+	length = std::min(len - offset, maxLen);
+	return data() + offset;
+#else
+	(void)offset;
+	(void)maxLen;
+	(void)length;
+	return nullptr;
+#endif
+}
+
+uint32_t ObjectBase::hash() const
+{
+	constexpr uint32_t fnvPrime = 16777619U;
+	uint32_t hash = 2166136261U;
+	uint8_t buffer[64];
+	size_t offset = 0;
+	size_t count;
+	while((count = read(offset, buffer, sizeof(buffer))) != 0) {
+		for(unsigned i = 0; i < count; ++i) {
+			hash = (hash ^ buffer[i]) * fnvPrime;
+		}
+		offset += count;
+	}
+	return hash;
+}
+
+bool ObjectBase::digest(ObjectDigest& digest) const
+{
+	if(!hasDigest()) {
+		return false;
+	}
+
+	memcpy_P(&digest, data() + size(), sizeof(digest));
+	return true;
+}
+
+uint32_t ObjectBase::crc32(uint32_t crc) const
+{
+	// Nibble-wise lookup for reflected polynomial 0xEDB88320
+	static const uint32_t crcTable[] PROGMEM = {
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+	};
+
+	crc = ~crc;
+	uint8_t buffer[64];
+	size_t offset = 0;
+	size_t count;
+	while((count = readFlash(offset, buffer, sizeof(buffer))) != 0) {
+		for(unsigned i = 0; i < count; ++i) {
+			crc ^= buffer[i];
+			crc = pgm_read_dword(&crcTable[crc & 0x0f]) ^ (crc >> 4);
+			crc = pgm_read_dword(&crcTable[crc & 0x0f]) ^ (crc >> 4);
+		}
+		offset += count;
+	}
+	return ~crc;
+}
+
+bool ObjectBase::verify() const
+{
+	ObjectDigest d;
+	return digest(d) && crc32() == d.crc32;
+}
+
 const uint8_t* ObjectBase::data() const
 {
 	return reinterpret_cast<const uint8_t*>(&flashLength_ + 1);
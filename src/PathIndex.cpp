@@ -0,0 +1,53 @@
+/****
+ * PathIndex.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/PathIndex.hpp"
+
+namespace FSTR
+{
+int PathIndex::indexOf(const char* path, size_t pathLength) const
+{
+	auto hash = pathHash(path, pathLength);
+	auto items = data();
+
+	// Find first entry with matching hash
+	unsigned first = 0;
+	unsigned count = length();
+	while(count > 0) {
+		auto step = count / 2;
+		auto mid = first + step;
+		if(readValue(&items[mid].hash) < hash) {
+			first = mid + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	// Check path for each entry with the same hash
+	for(unsigned i = first; i < length() && readValue(&items[i].hash) == hash; ++i) {
+		if(pathPtr(readValue(&items[i].pathOffset))->equals(path, pathLength)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+} // namespace FSTR
@@ -0,0 +1,139 @@
+/****
+ * PrintFormat.cpp - Formatting options for Array and Map printers
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/PrintFormat.hpp"
+#include <string.h>
+#include <algorithm>
+
+namespace
+{
+/*
+ * Collects output from Print methods so it can be padded
+ */
+class TextBuffer : public Print
+{
+public:
+	size_t write(uint8_t c) override
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* data, size_t size) override
+	{
+		size = std::min(size, sizeof(buffer) - length);
+		memcpy(buffer + length, data, size);
+		length += size;
+		return size;
+	}
+
+	using Print::write;
+
+	char buffer[32];
+	size_t length{0};
+};
+
+/*
+ * Integers are converted using the smallest suitable type as 64-bit division is slow on some architectures
+ */
+template <typename T> size_t printInteger(Print& p, const FSTR::PrintFormat& format, T value, bool negative)
+{
+	unsigned base = (format.radix < 2 || format.radix > 36) ? 10 : format.radix;
+
+	char buf[66];
+	char* ptr = &buf[sizeof(buf)];
+	do {
+		auto digit = unsigned(value % base);
+		*--ptr = (digit < 10) ? '0' + digit : 'a' + digit - 10;
+		value /= base;
+	} while(value != 0);
+	if(negative) {
+		*--ptr = '-';
+	}
+
+	return format.printPadded(p, ptr, &buf[sizeof(buf)] - ptr);
+}
+
+} // namespace
+
+namespace FSTR
+{
+size_t PrintFormat::printSeparator(Print& p, unsigned index) const
+{
+	bool newLine = itemsPerLine != 0 && index % itemsPerLine == 0;
+	size_t count = 0;
+	if(index > 0) {
+		auto len = strlen(separator);
+		if(newLine) {
+			while(len > 0 && separator[len - 1] == ' ') {
+				--len;
+			}
+		}
+		count += p.write(separator, len);
+	}
+	if(newLine) {
+		count += p.println();
+		count += p.print(indent);
+	}
+	return count;
+}
+
+size_t PrintFormat::printEnd(Print& p) const
+{
+	size_t count = 0;
+	if(itemsPerLine != 0) {
+		count += p.println();
+	}
+	count += p.print(suffix);
+	return count;
+}
+
+size_t PrintFormat::printNumber(Print& p, uint32_t value, bool negative) const
+{
+	return printInteger(p, *this, value, negative);
+}
+
+size_t PrintFormat::printNumber(Print& p, uint64_t value, bool negative) const
+{
+	return printInteger(p, *this, value, negative);
+}
+
+size_t PrintFormat::printNumber(Print& p, double value) const
+{
+	TextBuffer text;
+	text.print(value, precision);
+	return printPadded(p, text.buffer, text.length);
+}
+
+size_t PrintFormat::printPadded(Print& p, const char* text, size_t length) const
+{
+	size_t count = 0;
+	unsigned padding = (width > length) ? width - length : 0;
+	if(fill == '0' && length != 0 && text[0] == '-') {
+		count += p.print('-');
+		++text;
+		--length;
+	}
+	for(; padding > 0; --padding) {
+		count += p.print(fill);
+	}
+	count += p.write(text, length);
+	return count;
+}
+
+} // namespace FSTR
@@ -0,0 +1,95 @@
+/****
+ * PrintJob.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/PrintJob.hpp"
+#include <Platform/System.h>
+
+namespace FSTR
+{
+size_t PrintJob::step(size_t maxBytes)
+{
+	size_t total = 0;
+	while(!finished && total < maxBytes) {
+		if(!started) {
+			if(!nextSegment()) {
+				finished = true;
+				break;
+			}
+			started = true;
+			segmentPos = 0;
+		}
+
+		size_t count;
+		size_t written;
+		if(object == nullptr) {
+			count = std::min(textBuffer.length() - segmentPos, maxBytes - total);
+			auto ptr = reinterpret_cast<const uint8_t*>(textBuffer.c_str()) + segmentPos;
+			written = count ? output.write(ptr, count) : 0;
+		} else {
+			auto ptr = object->getDirectBuffer(segmentPos, maxBytes - total, count);
+			if(ptr != nullptr) {
+				written = output.write(ptr, count);
+			} else {
+				uint8_t buffer[128];
+				count = object->readFlash(segmentPos, buffer, std::min(sizeof(buffer), maxBytes - total));
+				written = count ? output.write(buffer, count) : 0;
+			}
+		}
+
+		segmentPos += written;
+		total += written;
+		if(count == 0) {
+			// Segment complete
+			started = false;
+			continue;
+		}
+		if(written < count) {
+			// Output is full
+			break;
+		}
+	}
+
+	writeCount += total;
+	return total;
+}
+
+bool PrintJob::submit(size_t bytesPerTask, CompleteCallback callback)
+{
+	this->bytesPerTask = bytesPerTask;
+	this->callback = callback;
+	error = false;
+	return System.queueCallback([this]() { runTask(); });
+}
+
+void PrintJob::runTask()
+{
+	step(bytesPerTask);
+	if(!finished) {
+		if(System.queueCallback([this]() { runTask(); })) {
+			return;
+		}
+		// Task queue is full: stop here and let the caller decide what to do
+		error = true;
+	}
+	if(callback) {
+		callback(*this);
+	}
+}
+
+} // namespace FSTR
@@ -0,0 +1,191 @@
+/****
+ * RangeStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/RangeStream.hpp"
+#include <cstdio>
+#include <new>
+
+namespace
+{
+/*
+ * Determine new position for seek operation
+ * @retval int -1 if out of range
+ */
+int getSeekPos(int offset, SeekOrigin origin, size_t pos, size_t length)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = pos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = length + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	return (newPos > length) ? -1 : int(newPos);
+}
+
+} // namespace
+
+namespace FSTR
+{
+/* RangeStream */
+
+RangeStream::RangeStream(const ObjectBase& object, size_t offset, size_t length) : object(object)
+{
+	auto objectLength = object.length();
+	this->offset = std::min(offset, objectLength);
+	this->length = std::min(length, objectLength - this->offset);
+}
+
+uint16_t RangeStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(bufSize <= 0) {
+		return 0;
+	}
+	auto count = std::min(size_t(bufSize), length - readPos);
+	return object.readFlash(offset + readPos, data, count);
+}
+
+int RangeStream::seekFrom(int offset, SeekOrigin origin)
+{
+	int newPos = getSeekPos(offset, origin, readPos, length);
+	if(newPos >= 0) {
+		readPos = newPos;
+	}
+	return newPos;
+}
+
+/* MultipartRangeStream */
+
+MultipartRangeStream::MultipartRangeStream(const ObjectBase& object, std::initializer_list<ByteRange> ranges,
+										   const char* contentType, const char* boundary)
+	: object(object), contentType(contentType ? contentType : ""), boundary(boundary ? boundary : "")
+{
+	this->ranges.reset(new(std::nothrow) ByteRange[ranges.size()]);
+	if(!this->ranges) {
+		return;
+	}
+
+	auto objectLength = object.length();
+	for(auto& r : ranges) {
+		auto& range = this->ranges[rangeCount];
+		range.offset = std::min(size_t(r.offset), objectLength);
+		range.length = std::min(size_t(r.length), objectLength - range.offset);
+		if(range.length != 0) {
+			++rangeCount;
+		}
+	}
+
+	// Allow for longest part header
+	auto headerSize = strlen(this->contentType) + strlen(this->boundary) + 100;
+	headerBuffer.reset(new(std::nothrow) char[headerSize]);
+	unsigned segmentCount = rangeCount * 2 + 1;
+	segmentStarts.reset(new(std::nothrow) uint32_t[segmentCount + 1]);
+	if(!headerBuffer || !segmentStarts) {
+		return;
+	}
+
+	for(unsigned i = 0; i < segmentCount; ++i) {
+		segmentStarts[i] = totalLength;
+		if(i & 1) {
+			totalLength += this->ranges[i / 2].length;
+		} else {
+			getHeader(i);
+			totalLength += headerLength;
+		}
+	}
+	segmentStarts[segmentCount] = totalLength;
+}
+
+const char* MultipartRangeStream::getHeader(unsigned segment)
+{
+	if(segment == headerSegment) {
+		return headerBuffer.get();
+	}
+
+	auto part = segment / 2;
+	auto buf = headerBuffer.get();
+	auto delim = (part == 0) ? "" : "\r\n";
+	if(part == rangeCount) {
+		headerLength = sprintf(buf, "%s--%s--\r\n", delim, boundary);
+	} else {
+		auto& range = ranges[part];
+		// Content-Range requires inclusive end position
+		auto last = range.offset + range.length - 1;
+		headerLength = sprintf(buf, "%s--%s\r\nContent-Type: %s\r\nContent-Range: bytes %u-%u/%u\r\n\r\n", delim,
+							   boundary, contentType, unsigned(range.offset), unsigned(last),
+							   unsigned(object.length()));
+	}
+	headerSegment = segment;
+	return buf;
+}
+
+size_t MultipartRangeStream::readSegment(unsigned segment, size_t offset, char* data, size_t count)
+{
+	if(segment & 1) {
+		auto& range = ranges[segment / 2];
+		count = std::min(count, range.length - offset);
+		return object.readFlash(range.offset + offset, data, count);
+	}
+
+	auto text = getHeader(segment);
+	count = std::min(count, headerLength - offset);
+	memcpy(data, text + offset, count);
+	return count;
+}
+
+uint16_t MultipartRangeStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(!isValid() || bufSize <= 0) {
+		return 0;
+	}
+
+	// Locate segment containing current position
+	unsigned segmentCount = rangeCount * 2 + 1;
+	auto starts = segmentStarts.get();
+	unsigned segment = std::upper_bound(starts, starts + segmentCount, readPos) - starts - 1;
+
+	size_t copied = 0;
+	size_t offset = readPos - starts[segment];
+	while(copied < size_t(bufSize) && segment < segmentCount) {
+		copied += readSegment(segment, offset, data + copied, bufSize - copied);
+		++segment;
+		offset = 0;
+	}
+
+	return copied;
+}
+
+int MultipartRangeStream::seekFrom(int offset, SeekOrigin origin)
+{
+	int newPos = getSeekPos(offset, origin, readPos, totalLength);
+	if(newPos >= 0) {
+		readPos = newPos;
+	}
+	return newPos;
+}
+
+} // namespace FSTR
@@ -0,0 +1,136 @@
+/****
+ * Serialize.cpp - Support for serializing objects directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Serialize.hpp"
+#include "include/FlashString/BufferedPrint.hpp"
+
+namespace
+{
+unsigned stringLength(const void* object)
+{
+	return static_cast<const FSTR::ObjectBase*>(object)->length();
+}
+
+} // namespace
+
+namespace FSTR
+{
+namespace Serialize
+{
+const TypeInfo stringTypeInfo{Kind::string, ElementClass::other, 1, stringLength, nullptr};
+
+void Generator::restart()
+{
+	depth = 0;
+	textPos = textLength = 0;
+	Value value;
+	value.setObject(root, *rootType);
+	push(value);
+}
+
+bool Generator::push(const Value& value)
+{
+	if(depth == FSTR_SERIALIZE_MAX_DEPTH) {
+		return false;
+	}
+
+	auto& frame = stack[depth++];
+	frame.object = value.object;
+	frame.type = value.info;
+	frame.cursor = nullptr;
+	frame.length = value.info->length(value.object);
+	frame.index = 0;
+	frame.state = State::start;
+	return true;
+}
+
+void Generator::emitContent(Frame& frame, size_t size)
+{
+	auto object = static_cast<const ObjectBase*>(frame.object);
+	auto len = object->readFlash(frame.index, &text[textLength], std::min(space(), size - frame.index));
+	textLength += len;
+	frame.index += len;
+}
+
+size_t Generator::fill()
+{
+	if(textPos == textLength) {
+		textPos = textLength = 0;
+		while(textLength == 0 && depth != 0) {
+			step();
+		}
+	}
+	return textLength - textPos;
+}
+
+size_t Generator::read(void* buffer, size_t size)
+{
+	auto ptr = static_cast<uint8_t*>(buffer);
+	size_t count = 0;
+	while(count < size) {
+		auto len = std::min(fill(), size - count);
+		if(len == 0) {
+			break;
+		}
+		memcpy(ptr + count, &text[textPos], len);
+		textPos += len;
+		count += len;
+	}
+	return count;
+}
+
+size_t Generator::skip(size_t count)
+{
+	size_t skipped = 0;
+	while(skipped < count) {
+		auto len = std::min(fill(), count - skipped);
+		if(len == 0) {
+			break;
+		}
+		textPos += len;
+		skipped += len;
+	}
+	return skipped;
+}
+
+size_t Generator::printTo(Print& p)
+{
+	BufferedPrint<> output(p);
+	size_t len;
+	while((len = fill()) != 0) {
+		auto written = output.write(&text[textPos], len);
+		textPos += written;
+		if(written != len) {
+			break;
+		}
+	}
+	output.flush();
+	return output.getOutputLength();
+}
+
+size_t Generator::measure()
+{
+	restart();
+	auto length = skip(SIZE_MAX);
+	restart();
+	return length;
+}
+
+} // namespace Serialize
+} // namespace FSTR
@@ -20,6 +20,7 @@
  ****/
 
 #include "include/FlashString/Stream.hpp"
+#include <Print.h>
 
 namespace FSTR
 {
@@ -32,6 +33,29 @@ uint16_t Stream::readMemoryBlock(char* data, int bufSize)
 	}
 }
 
+size_t Stream::writeTo(Print& p, size_t maxLen)
+{
+	size_t total = 0;
+	while(total < maxLen && !isFinished()) {
+		size_t count;
+		auto ptr = getDirectBuffer(maxLen - total, count);
+		size_t written;
+		if(ptr != nullptr) {
+			written = p.write(ptr, count);
+		} else {
+			char buffer[256];
+			count = readMemoryBlock(buffer, std::min(sizeof(buffer), maxLen - total));
+			written = p.write(reinterpret_cast<uint8_t*>(buffer), count);
+		}
+		readPos += written;
+		total += written;
+		if(written != count) {
+			break;
+		}
+	}
+	return total;
+}
+
 int Stream::seekFrom(int offset, SeekOrigin origin)
 {
 	size_t newPos;
@@ -25,6 +25,13 @@ namespace FSTR
 {
 size_t StringPrinter::printTo(Print& p) const
 {
+	// Write directly from flash if possible
+	size_t directLength;
+	auto ptr = string.getDirectBuffer(0, string.length(), directLength);
+	if(ptr != nullptr) {
+		return p.write(ptr, directLength);
+	}
+
 	// Print in chunks
 	char buffer[256];
 	size_t offset = 0;
@@ -0,0 +1,65 @@
+/****
+ * Utility.cpp - Helper functions for reading flash memory
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Utility.hpp"
+#include <string.h>
+
+namespace FSTR
+{
+/*
+ * Assumes little-endian byte order, so lower addresses are in the least significant bits of a word.
+ */
+void readUnaligned(void* dst, const void* src, size_t size)
+{
+	if(size == 0) {
+		return;
+	}
+
+	auto out = static_cast<uint8_t*>(dst);
+	auto offset = uintptr_t(src) & 3;
+	auto wptr = reinterpret_cast<const uint32_t*>(uintptr_t(src) - offset);
+	unsigned shift = offset * 8;
+	uint32_t word = pgm_read_dword(wptr);
+
+	// Each whole output word combines the end of one flash word with the start of the next
+	for(; size >= 4; size -= 4, out += 4) {
+		uint32_t value = word >> shift;
+		if(shift != 0 || size > 4) {
+			word = pgm_read_dword(++wptr);
+			if(shift != 0) {
+				value |= word << (32 - shift);
+			}
+		}
+		memcpy(out, &value, sizeof(value));
+	}
+
+	// Up to 3 bytes remain
+	uint32_t value = word >> shift;
+	unsigned avail = 4 - offset;
+	for(; size != 0; --size, --avail) {
+		if(avail == 0) {
+			value = pgm_read_dword(++wptr);
+			avail = 4;
+		}
+		*out++ = uint8_t(value);
+		value >>= 8;
+	}
+}
+
+} // namespace FSTR
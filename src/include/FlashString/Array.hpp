@@ -23,6 +23,7 @@
 
 #include "Object.hpp"
 #include "ArrayPrinter.hpp"
+#include "FieldView.hpp"
 
 /**
  * @defgroup fstr_array Arrays
@@ -131,15 +132,27 @@ public:
 	 * @brief Returns a printer object for this array
 	 * @note ElementType must be supported by Print
 	 */
-	ArrayPrinter<Array> printer() const
+	ArrayPrinter<Array> printer(const PrintFormat& format = {}) const
 	{
-		return ArrayPrinter<Array>(*this);
+		return ArrayPrinter<Array>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
 	{
 		return printer().printTo(p);
 	}
+
+	/**
+	 * @brief Get a view of one field in each element
+	 * @tparam Member Pointer to a data member of ElementType, e.g. `&MyRecord::id`
+	 * @note Searching or scanning a field this way reads only the field, not the whole element
+	 */
+	template <auto Member> FieldView<Member> project() const
+	{
+		static_assert(std::is_same<typename FieldView<Member>::RecordType, ElementType>::value,
+					  "Member does not belong to Array ElementType");
+		return FieldView<Member>(this->data(), this->length());
+	}
 } FSTR_PACKED;
 
 } // namespace FSTR
@@ -19,48 +19,44 @@
 
 #pragma once
 
-#include "Print.hpp"
+#include "PrintFormat.hpp"
+#include "BufferedPrint.hpp"
 #include <stringutil.h>
 
 namespace FSTR
 {
-template <typename T>
-typename std::enable_if<!std::is_same<T, char>::value, size_t>::type printElement(Print& p, const T& e)
-{
-	return print(p, e);
-}
-
-size_t printElement(Print& p, char c);
-
 /**
  * @brief Class template to provide a simple way to print the contents of an array
  * @note Used by Array::printTo() method
+ *
+ * Output is collected in a BufferedPrint staging buffer to minimise write calls.
+ * Layout and number formatting may be customised using a PrintFormat.
  */
 template <class ArrayType> class ArrayPrinter
 {
 public:
-	ArrayPrinter(const ArrayType& array) : array(array)
+	ArrayPrinter(const ArrayType& array, const PrintFormat& format = {}) : array(array), format(format)
 	{
 	}
 
-	size_t printTo(Print& p) const
+	size_t printTo(Print& output) const
 	{
-		size_t count = 0;
+		BufferedPrint<> p(output);
 
-		count += p.print('{');
+		format.printStart(p);
 		for(unsigned i = 0; i < array.length(); ++i) {
-			if(i > 0) {
-				count += p.print(", ");
-			}
-			count += printElement(p, array[i]);
+			format.printSeparator(p, i);
+			printElement(p, array[i], format);
 		}
-		count += p.print('}');
+		format.printEnd(p);
 
-		return count;
+		p.flush();
+		return p.getOutputLength();
 	}
 
 private:
 	const ArrayType& array;
+	PrintFormat format;
 };
 
 } // namespace FSTR
@@ -0,0 +1,96 @@
+/****
+ * BinaryStream.hpp - Serialize objects as CBOR or MessagePack directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "SerializeStream.hpp"
+
+/**
+ * @defgroup fstr_binary CBOR and MessagePack
+ * @ingroup fstr_serialize
+ * @{
+ */
+
+namespace FSTR
+{
+enum class BinaryFormat {
+	CBOR,		 ///< RFC 8949
+	MessagePack, ///< https://msgpack.org
+};
+
+/**
+ * @brief Generates CBOR or MessagePack output for an object on demand
+ *
+ * Arrays of integral or floating-point values are output as byte strings copied directly from flash.
+ * For CBOR these are tagged as typed arrays (RFC 8746) in little-endian format.
+ * For MessagePack they are output as `bin` values, so the recipient must know the element type.
+ *
+ * Floating-point values which can be represented exactly in single precision are output as such.
+ */
+class BinaryGenerator : public Serialize::Generator
+{
+public:
+	template <class ObjectType>
+	BinaryGenerator(const ObjectType& object, BinaryFormat format) : Generator(object), format(format)
+	{
+	}
+
+	BinaryFormat getFormat() const
+	{
+		return format;
+	}
+
+protected:
+	void step() override;
+
+private:
+	enum class Header {
+		bytes,
+		text,
+		array,
+		map,
+	};
+
+	void emitValue(const Serialize::Value& value);
+	void emitScalar(const Serialize::Value& value);
+	void emitHeader(Header header, size_t length);
+	void emitTypedArrayHeader(const Serialize::TypeInfo& type, size_t size);
+	void emitCborHeader(uint8_t majorType, uint64_t value);
+	void emitBigEndian(uint64_t value, uint8_t size);
+
+	BinaryFormat format;
+};
+
+/**
+ * @brief Stream providing an object serialized as CBOR or MessagePack
+ *
+ * Example:
+ *
+ * 		auto stream = new FSTR::BinaryStream(myMap, FSTR::BinaryFormat::CBOR);
+ * 		response.sendDataStream(stream, F("application/cbor"));
+ */
+class BinaryStream : public Serialize::GeneratorStream<BinaryGenerator>
+{
+public:
+	using GeneratorStream::GeneratorStream;
+};
+
+} // namespace FSTR
+
+/** @} */
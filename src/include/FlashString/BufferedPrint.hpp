@@ -0,0 +1,156 @@
+/****
+ * BufferedPrint.hpp - Print adapter to combine small writes
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "config.hpp"
+#include <Print.h>
+#include <algorithm>
+
+#ifndef FSTR_PRINT_BUFFER_SIZE
+/**
+ * @brief Size of staging buffer used by ArrayPrinter and MapPrinter
+ * @ingroup fstr_print
+ */
+#define FSTR_PRINT_BUFFER_SIZE 128
+#endif
+
+namespace FSTR
+{
+/**
+ * @brief Collects small writes into a staging buffer and passes them on in larger blocks
+ * @ingroup fstr_print
+ * @tparam BufferSize
+ *
+ * Printers generate many small writes for braces, separators and elements.
+ * These are costly for outputs such as network connections or UARTs.
+ *
+ * The buffer is filled completely before being written out.
+ * Writes of at least the buffer size are passed straight through after flushing any buffered data.
+ * Data is flushed when the object is destroyed.
+ *
+ * Buffered data may be rejected later by the output, so callers which need an accurate count
+ * should call flush() and then getOutputLength(). Once the output fails to accept data, all
+ * further writes are discarded.
+ */
+template <size_t BufferSize = FSTR_PRINT_BUFFER_SIZE> class BufferedPrint : public Print
+{
+public:
+	BufferedPrint(Print& output) : output(output)
+	{
+	}
+
+	BufferedPrint(const BufferedPrint&) = delete;
+	BufferedPrint& operator=(const BufferedPrint&) = delete;
+
+	~BufferedPrint()
+	{
+		flush();
+	}
+
+	size_t write(uint8_t c) override
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* data, size_t size) override
+	{
+		++writeCount;
+		if(failed) {
+			return 0;
+		}
+		if(size >= BufferSize) {
+			if(!flush()) {
+				return 0;
+			}
+			++outputCount;
+			auto written = output.write(data, size);
+			outputLength += written;
+			failed = (written != size);
+			return written;
+		}
+		auto n = std::min(size, BufferSize - length);
+		memcpy(buffer + length, data, n);
+		length += n;
+		if(n < size) {
+			if(!flush()) {
+				return 0;
+			}
+			memcpy(buffer, data + n, size - n);
+			length = size - n;
+		}
+		return size;
+	}
+
+	using Print::write;
+
+	/**
+	 * @brief Write any buffered data to the output
+	 * @retval bool false if output did not accept all the data, which is discarded
+	 */
+	bool flush()
+	{
+		if(failed || length == 0) {
+			length = 0;
+			return !failed;
+		}
+		++outputCount;
+		auto written = output.write(buffer, length);
+		outputLength += written;
+		failed = (written != length);
+		length = 0;
+		return !failed;
+	}
+
+	/**
+	 * @brief Get number of bytes accepted by the output
+	 * @note Does not include data still in the buffer
+	 */
+	size_t getOutputLength() const
+	{
+		return outputLength;
+	}
+
+	/**
+	 * @brief Get number of write calls received
+	 */
+	unsigned getWriteCount() const
+	{
+		return writeCount;
+	}
+
+	/**
+	 * @brief Get number of write calls made to the output
+	 */
+	unsigned getOutputCount() const
+	{
+		return outputCount;
+	}
+
+private:
+	Print& output;
+	uint8_t buffer[BufferSize];
+	size_t length{0};
+	size_t outputLength{0};
+	unsigned writeCount{0};
+	unsigned outputCount{0};
+	bool failed{false};
+};
+
+} // namespace FSTR
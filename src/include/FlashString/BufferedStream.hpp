@@ -0,0 +1,112 @@
+/****
+ * BufferedStream.hpp - Flash stream with read-ahead buffering
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "ObjectBase.hpp"
+#include <Data/Stream/DataSourceStream.h>
+#include <memory>
+
+namespace FSTR
+{
+/**
+ * @brief Stream which reads flash data in aligned blocks
+ * @ingroup fstr_stream
+ *
+ * FSTR::Stream reads exactly what is requested, so many small or misaligned requests
+ * each incur a separate flash read. This stream reads whole blocks using `readFlash()`
+ * into a RAM buffer divided into two halves. Consecutive blocks occupy alternate halves,
+ * so requests spanning a block boundary are served without discarding the previous block.
+ *
+ * Peeking with `readMemoryBlock()` and seeking only re-read flash if the required block
+ * is not already buffered. Requests for a whole block or more, starting on a block boundary,
+ * bypass the buffer and are read directly into the caller's buffer.
+ */
+class BufferedStream : public IDataSourceStream
+{
+public:
+	static constexpr size_t defaultBufferSize = 512;
+
+	/**
+	 * @brief Constructor
+	 * @param object
+	 * @param bufferSize Total size of buffer to allocate, rounded up to a multiple of 8 bytes
+	 */
+	BufferedStream(const ObjectBase& object, size_t bufferSize = defaultBufferSize);
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	bool isValid() const override
+	{
+		return bool(buffer);
+	}
+
+	int available() override
+	{
+		return int(object.length() - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= object.length();
+	}
+
+	/**
+	 * @brief Get the size of each buffered block
+	 */
+	size_t getBlockSize() const
+	{
+		return blockSize;
+	}
+
+	/**
+	 * @brief Get the number of flash reads performed
+	 * @note Provided for profiling
+	 */
+	unsigned getReadCount() const
+	{
+		return readCount;
+	}
+
+private:
+	static constexpr uint32_t blockNone = 0xffffffff;
+
+	uint8_t* slot(unsigned index) const
+	{
+		return reinterpret_cast<uint8_t*>(buffer.get()) + index * blockSize;
+	}
+
+	const uint8_t* getBlock(size_t block);
+
+	const ObjectBase& object;
+	std::unique_ptr<uint32_t[]> buffer; ///< Use words to ensure alignment
+	size_t blockSize;
+	size_t readPos{0};
+	uint32_t blocks[2]{blockNone, blockNone}; ///< Index of block held in each half of buffer
+	unsigned readCount{0};
+};
+
+} // namespace FSTR
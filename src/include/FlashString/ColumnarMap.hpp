@@ -0,0 +1,298 @@
+/****
+ * ColumnarMap.hpp - Defines the ColumnarMap class template and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "MapPair.hpp"
+#include "MapPrinter.hpp"
+
+/**
+ * @defgroup fstr_columnar_map Columnar Maps
+ * @ingroup fstr_map
+ * @{
+ */
+
+/**
+ * @brief Declare a global ColumnarMap& reference
+ * @param name Name of the ColumnarMap& reference to define
+ * @param KeyType Integral, enum or floating-point type to use for key
+ * @param ContentType Object type to declare for content
+ * @note Use DEFINE_FSTR_COLUMNAR_MAP to instantiate the global object
+ */
+#define DECLARE_FSTR_COLUMNAR_MAP(name, KeyType, ContentType)                                                          \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::ColumnarMap<KeyType, ContentType>)))
+
+/**
+ * @brief Define a ColumnarMap Object with global reference
+ * @param name Name of the ColumnarMap& reference to define
+ * @param KeyType Integral, enum or floating-point type to use for key
+ * @param ContentType Object type to declare for content
+ * @param keys Parenthesised list of keys
+ * @param contents Parenthesised list of content pointers, in the same order as keys
+ * @note Size will be calculated
+ *
+ * Example:
+ *
+ * 		DEFINE_FSTR_COLUMNAR_MAP(myMap, MapKey, FSTR::String, (KeyA, KeyB), (&content1, &content2))
+ */
+#define DEFINE_FSTR_COLUMNAR_MAP(name, KeyType, ContentType, keys, contents)                                           \
+	static DEFINE_FSTR_COLUMNAR_MAP_DATA(FSTR_DATA_NAME(name), KeyType, ContentType, keys, contents);                  \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_COLUMNAR_MAP except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_COLUMNAR_MAP_LOCAL(name, KeyType, ContentType, keys, contents)                                     \
+	static DEFINE_FSTR_COLUMNAR_MAP_DATA(FSTR_DATA_NAME(name), KeyType, ContentType, keys, contents);                  \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a ColumnarMap data structure
+ * @param name Name of data structure
+ * @param KeyType Integral, enum or floating-point type to use for key
+ * @param ContentType Object type to declare for content
+ * @param keys Parenthesised list of keys
+ * @param contents Parenthesised list of content pointers
+ * @note Size will be calculated
+ */
+#define DEFINE_FSTR_COLUMNAR_MAP_DATA(name, KeyType, ContentType, keys, contents)                                      \
+	DEFINE_FSTR_COLUMNAR_MAP_DATA_SIZED(name, KeyType, ContentType, FSTR_VA_NARGS(KeyType, FSTR_UNPAREN keys), keys,  \
+										contents)
+
+/**
+ * @brief Define a ColumnarMap data structure, specifying the number of elements
+ * @param name Name of data structure
+ * @param KeyType Integral, enum or floating-point type to use for key
+ * @param ContentType Object type to declare for content
+ * @param size Number of elements
+ * @param keys Parenthesised list of keys
+ * @param contents Parenthesised list of content pointers
+ *
+ * All keys are stored together, padded to a word boundary, followed by the content pointers.
+ * The number of keys and content pointers must both equal the given size.
+ */
+#define DEFINE_FSTR_COLUMNAR_MAP_DATA_SIZED(name, KeyType, ContentType, size, keys, contents)                          \
+	constexpr const struct {                                                                                           \
+		FSTR::ColumnarMap<KeyType, ContentType> object;                                                                \
+		KeyType data[FSTR::ColumnarMap<KeyType, ContentType>::keyBlockCount(size)];                                    \
+		const ContentType* content[size];                                                                              \
+	} FSTR_PACKED name PROGMEM = {{sizeof(KeyType) * size}, {FSTR_UNPAREN keys}, {FSTR_UNPAREN contents}};             \
+	static_assert(FSTR_VA_NARGS(KeyType, FSTR_UNPAREN keys) == (size), "ColumnarMap key count does not match size");   \
+	static_assert(FSTR_VA_NARGS(ContentType*, FSTR_UNPAREN contents) == (size),                                        \
+				  "ColumnarMap content count does not match number of keys");                                          \
+	FSTR_CHECK_STRUCT(name);
+
+namespace FSTR
+{
+/**
+ * @brief Class template to access an associative map with keys and content stored separately
+ * @tparam KeyType
+ * @tparam ContentType
+ *
+ * Functionally equivalent to a Map but the keys are stored contiguously, so a search reads
+ * only key data. 1 and 2-byte keys are compared a whole word at a time.
+ */
+template <typename KeyType, class ContentType>
+class ColumnarMap : public Object<ColumnarMap<KeyType, ContentType>, KeyType>
+{
+public:
+	static_assert(!std::is_class<KeyType>::value, "ColumnarMap does not support class keys - use Map");
+	static_assert(sizeof(KeyType) == 1 || sizeof(KeyType) == 2 || sizeof(KeyType) == 4 || sizeof(KeyType) == 8,
+				  "Unsupported ColumnarMap key size");
+
+	using Pair = MapPair<KeyType, ContentType>;
+	using ContentPtrType = const ContentType* const*;
+
+	/**
+	 * @brief Iterator returns MapPair values, as for Map
+	 */
+	class Iterator
+	{
+	public:
+		Iterator(const ColumnarMap& map, unsigned index) : map(map), index(index)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &map == &rhs.map && index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		const Pair operator*() const
+		{
+			return map.valueAt(index);
+		}
+
+	private:
+		const ColumnarMap& map;
+		unsigned index;
+	};
+
+	/**
+	 * @brief Get number of key elements to allocate, including padding to word boundary
+	 */
+	static constexpr size_t keyBlockCount(size_t count)
+	{
+		return ALIGNUP4(sizeof(KeyType) * count) / sizeof(KeyType);
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, this->length());
+	}
+
+	/**
+	 * @brief Get a map entry by index, if it exists
+	 * @note Result validity can be checked using if()
+	 */
+	const Pair valueAt(unsigned index) const
+	{
+		if(index >= this->length()) {
+			return Pair::empty();
+		}
+
+		return Pair{this->unsafeValueAt(this->data(), index), readValue(contentData() + index)};
+	}
+
+	/**
+	 * @brief Get the key for an entry
+	 * @param index
+	 * @retval KeyType Value-initialised if index is out of range
+	 */
+	KeyType keyAt(unsigned index) const
+	{
+		return Object<ColumnarMap, KeyType>::valueAt(index);
+	}
+
+	/**
+	 * @brief Lookup a key and return the index
+	 * @param key Key to locate, must be compatible with KeyType for equality comparison
+	 * @retval int If key isn't found, return -1
+	 */
+	template <typename TRefKey> int indexOf(const TRefKey& key) const
+	{
+		auto k = static_cast<KeyType>(key);
+		if(!(k == key)) {
+			// Cannot be represented as KeyType
+			return -1;
+		}
+		return findKey(k);
+	}
+
+	/**
+	 * @brief Lookup a key and return the entry, if found
+	 * @param key
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> const Pair operator[](const TRefKey& key) const
+	{
+		return valueAt(indexOf(key));
+	}
+
+	/* Arduino Print support */
+
+	/**
+	 * @brief Returns a printer object for this map
+	 * @note ElementType must be supported by Print
+	 */
+	MapPrinter<ColumnarMap> printer(const PrintFormat& format = PrintFormat::forMap()) const
+	{
+		return MapPrinter<ColumnarMap>(*this, format);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		return printer().printTo(p);
+	}
+
+	/**
+	 * @brief Get pointer to start of content pointer table
+	 */
+	ContentPtrType contentData() const
+	{
+		return reinterpret_cast<ContentPtrType>(ObjectBase::data() + ObjectBase::size());
+	}
+
+private:
+	/*
+	 * Key block is word-aligned and padded, so small keys can be compared using whole words.
+	 * Detects matching bytes using the 'has zero byte' method, assuming little-endian storage.
+	 */
+	template <typename T = KeyType>
+	typename std::enable_if<sizeof(T) == 1 || sizeof(T) == 2, int>::type findKey(KeyType key) const
+	{
+		constexpr uint32_t lsb = (sizeof(T) == 1) ? 0x01010101U : 0x00010001U;
+		constexpr uint32_t msb = lsb << (sizeof(T) * 8 - 1);
+		constexpr unsigned keyBits = sizeof(T) * 8;
+		union {
+			T key;
+			typename std::conditional<sizeof(T) == 1, uint8_t, uint16_t>::type value;
+		} tmp;
+		tmp.key = key;
+		uint32_t pattern = tmp.value * lsb;
+		auto len = this->length();
+		auto wordptr = reinterpret_cast<const uint32_t*>(this->data());
+		for(unsigned i = 0; i < len; i += sizeof(uint32_t) / sizeof(T), ++wordptr) {
+			uint32_t x = pgm_read_dword(wordptr) ^ pattern;
+			uint32_t match = (x - lsb) & ~x & msb;
+			if(match != 0) {
+				unsigned index = i + (__builtin_ctz(match) / keyBits);
+				// Trailing padding may match a zero key
+				return (index < len) ? int(index) : -1;
+			}
+		}
+
+		return -1;
+	}
+
+	template <typename T = KeyType>
+	typename std::enable_if<(sizeof(T) > 2), int>::type findKey(KeyType key) const
+	{
+		auto dataptr = this->data();
+		auto len = this->length();
+		for(unsigned i = 0; i < len; ++i) {
+			if(this->unsafeValueAt(dataptr, i) == key) {
+				return int(i);
+			}
+		}
+
+		return -1;
+	}
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,198 @@
+/****
+ * CompiledTemplate.hpp - Templates pre-processed at build time
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Array.hpp"
+#include "Vector.hpp"
+#include <Data/Stream/DataSourceStream.h>
+#include <memory>
+
+/**
+ * @defgroup fstr_compiled_template Compiled Templates
+ * @ingroup fstr_stream
+ * @{
+ */
+
+/**
+ * @brief Declare a global CompiledTemplate& reference
+ * @param name
+ */
+#define DECLARE_FSTR_TEMPLATE(name) DECLARE_FSTR_OBJECT(name, FSTR::CompiledTemplate)
+
+/**
+ * @brief Define a CompiledTemplate Object with global reference
+ * @param name Name of CompiledTemplate& reference to define
+ * @param text String containing template text with all variable tags removed
+ * @param variables Vector of String containing variable names
+ * @param fields Array of TemplateField locating each variable within the text
+ * @note This is usually generated using `tools/fstrtemplate.py`
+ */
+#define DEFINE_FSTR_TEMPLATE(name, text, variables, fields)                                                            \
+	static DEFINE_FSTR_TEMPLATE_DATA(FSTR_DATA_NAME(name), text, variables, fields);                                   \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_TEMPLATE except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_TEMPLATE_LOCAL(name, text, variables, fields)                                                      \
+	static DEFINE_FSTR_TEMPLATE_DATA(FSTR_DATA_NAME(name), text, variables, fields);                                   \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a CompiledTemplate data structure
+ */
+#define DEFINE_FSTR_TEMPLATE_DATA(name, text, variables, fields)                                                       \
+	constexpr const struct {                                                                                           \
+		FSTR::CompiledTemplate object;                                                                                 \
+		FSTR::TemplateRecord data[1];                                                                                  \
+	} FSTR_PACKED name PROGMEM = {{sizeof(FSTR::TemplateRecord)}, {{&text, &variables, &fields}}};                     \
+	FSTR_CHECK_STRUCT(name);
+
+namespace FSTR
+{
+/**
+ * @brief Locates a variable within template text
+ */
+struct TemplateField {
+	uint32_t offset;   ///< Position in text where value is inserted
+	uint32_t variable; ///< Index into variable table
+};
+
+/**
+ * @brief Template definition
+ */
+struct TemplateRecord {
+	const String* text;
+	const Vector<String>* variables;
+	const Array<TemplateField>* fields;
+};
+
+/**
+ * @brief A template which has been split into text and variable fields at build time
+ *
+ * Unlike a regular TemplateStream, no scanning for tags is required at runtime.
+ */
+class CompiledTemplate : public Object<CompiledTemplate, TemplateRecord>
+{
+public:
+	/**
+	 * @brief Get the template text, with variable tags removed
+	 */
+	const String& text() const
+	{
+		return isNull() ? String::empty() : *readValue(&data()->text);
+	}
+
+	/**
+	 * @brief Get the table of variable names
+	 */
+	const Vector<String>& variables() const
+	{
+		return isNull() ? Vector<String>::empty() : *readValue(&data()->variables);
+	}
+
+	/**
+	 * @brief Get the table of field locations, in order of offset
+	 */
+	const Array<TemplateField>& fields() const
+	{
+		return isNull() ? Array<TemplateField>::empty() : *readValue(&data()->fields);
+	}
+} FSTR_PACKED;
+
+/**
+ * @brief Stream which outputs a CompiledTemplate, inserting variable values
+ *
+ * Output alternates between template text, read directly from flash, and variable values held in RAM.
+ * As all values are known before output starts, `available()` returns the exact total length.
+ * Variables which have not been set are output as empty strings.
+ */
+class CompiledTemplateStream : public IDataSourceStream
+{
+public:
+	CompiledTemplateStream(const CompiledTemplate& tmpl);
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	bool isValid() const override
+	{
+		return values || tmpl.variables().length() == 0;
+	}
+
+	int available() override;
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return available() <= 0;
+	}
+
+	/**
+	 * @brief Set value of a variable
+	 * @param name Variable name
+	 * @param value
+	 * @retval bool false if variable is not used in template
+	 */
+	bool setVar(const char* name, const WString& value)
+	{
+		return setVar(tmpl.variables().indexOf(name, false), value);
+	}
+
+	/**
+	 * @brief Set value of a variable by index
+	 * @param index Index of variable in table
+	 * @param value
+	 * @retval bool false if index is invalid
+	 */
+	bool setVar(int index, const WString& value);
+
+	/**
+	 * @brief Get value of a variable
+	 */
+	const WString& getVar(const char* name) const;
+
+private:
+	/*
+	 * Segments alternate between text and values, starting and ending with text.
+	 * Even segments are text, odd segments are values.
+	 */
+	size_t segmentLength(unsigned segment) const;
+	size_t textOffset(unsigned field) const;
+	size_t readSegment(unsigned segment, size_t offset, char* data, size_t count) const;
+	void findSegment(size_t pos);
+
+	const CompiledTemplate& tmpl;
+	std::unique_ptr<WString[]> values;
+	unsigned fieldCount;
+	size_t readPos{0};
+	unsigned segment{0};	   ///< Cached segment containing readPos
+	size_t segmentStart{0};	   ///< Output position of cached segment
+	int totalLength{-1};	   ///< Cached, reset when value changed
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,224 @@
+/****
+ * CsvPrinter.hpp - Print arrays of table rows or structures as CSV
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Array.hpp"
+
+#ifndef FSTR_CSV_BATCH_SIZE
+/**
+ * @brief Size of RAM buffer used to read rows from flash
+ * @ingroup fstr_csv
+ */
+#define FSTR_CSV_BATCH_SIZE 256
+#endif
+
+/**
+ * @defgroup fstr_csv CSV output
+ * @ingroup fstr_print
+ * @{
+ */
+
+namespace FSTR
+{
+/**
+ * @brief Describes a column for CSV output
+ */
+struct CsvColumn {
+	const char* heading;   ///< Text for the header line, nullptr for none
+	PrintFormat format{}; ///< How values in the column are printed
+};
+
+/**
+ * @brief Default field printer, used for TableRow and similar types providing `operator[]`
+ */
+template <typename RowType>
+size_t printCsvField(Print& p, const RowType& row, unsigned column, const PrintFormat& format)
+{
+	return printElement(p, row[column], format);
+}
+
+/**
+ * @brief Print an Array of TableRow or structure values as comma-separated values
+ * @tparam RowType Array element type
+ *
+ * Each element is printed as one line, terminated with CR/LF as per RFC 4180.
+ * Rows are read from flash in batches of up to FSTR_CSV_BATCH_SIZE bytes
+ * and output is collected in a BufferedPrint staging buffer.
+ *
+ * TableRow values are printed using the default field printer. For other structures provide a function
+ * to print each field:
+ *
+ * 		struct Reading {
+ * 			uint32_t time;
+ * 			float temperature;
+ * 		};
+ *
+ * 		size_t printReading(Print& p, const Reading& row, unsigned column, const FSTR::PrintFormat& format)
+ * 		{
+ * 			return column == 0 ? printElement(p, row.time, format) : printElement(p, row.temperature, format);
+ * 		}
+ *
+ * 		const FSTR::CsvColumn columns[]{{"time"}, {"temperature"}};
+ * 		Serial.print(FSTR::CsvPrinter<Reading>(readings, columns, ARRAY_SIZE(columns), printReading));
+ *
+ * Text escaping is not performed.
+ */
+template <typename RowType> class CsvPrinter
+{
+public:
+	using ArrayType = Array<RowType>;
+	using FieldPrinter = size_t (*)(Print& p, const RowType& row, unsigned column, const PrintFormat& format);
+
+	/**
+	 * @brief Print all columns using the same format, without a header line
+	 * @param array
+	 * @param format
+	 * @note RowType must provide `length()` and `operator[]`, as for TableRow
+	 */
+	CsvPrinter(const ArrayType& array, const PrintFormat& format = {})
+		: array(array), format(format), columnCount(RowType{}.length()), fieldPrinter(printCsvField<RowType>)
+	{
+	}
+
+	/**
+	 * @brief Print using column descriptions
+	 * @param array
+	 * @param columns Column descriptions, must remain valid for the lifetime of this object
+	 * @param columnCount Number of columns
+	 * @param fieldPrinter Function to print each field
+	 *
+	 * A header line is printed if any columns have a heading.
+	 */
+	CsvPrinter(const ArrayType& array, const CsvColumn* columns, unsigned columnCount,
+			   FieldPrinter fieldPrinter = printCsvField<RowType>)
+		: array(array), columns(columns), columnCount(columnCount), fieldPrinter(fieldPrinter)
+	{
+		for(unsigned i = 0; i < columnCount; ++i) {
+			if(columns[i].heading != nullptr) {
+				header = true;
+				break;
+			}
+		}
+	}
+
+	/**
+	 * @brief Set the character used to separate fields
+	 */
+	CsvPrinter& setDelimiter(char c)
+	{
+		delimiter = c;
+		return *this;
+	}
+
+	/**
+	 * @brief Get number of output lines, including any header
+	 */
+	unsigned lineCount() const
+	{
+		return (header ? 1 : 0) + array.length();
+	}
+
+	/**
+	 * @brief Print a single line
+	 * @param p
+	 * @param line Index of line, as for lineCount()
+	 */
+	size_t printLine(Print& p, unsigned line) const
+	{
+		if(header) {
+			if(line == 0) {
+				return printHeader(p);
+			}
+			--line;
+		}
+		RowType row;
+		if(array.read(line, &row, 1) != 1) {
+			return 0;
+		}
+		return printRow(p, row);
+	}
+
+	size_t printHeader(Print& p) const
+	{
+		size_t count = 0;
+		for(unsigned i = 0; i < columnCount; ++i) {
+			if(i != 0) {
+				count += p.print(delimiter);
+			}
+			if(columns[i].heading != nullptr) {
+				count += p.print(columns[i].heading);
+			}
+		}
+		count += p.println();
+		return count;
+	}
+
+	size_t printRow(Print& p, const RowType& row) const
+	{
+		size_t count = 0;
+		for(unsigned i = 0; i < columnCount; ++i) {
+			if(i != 0) {
+				count += p.print(delimiter);
+			}
+			count += fieldPrinter(p, row, i, columns ? columns[i].format : format);
+		}
+		count += p.println();
+		return count;
+	}
+
+	size_t printTo(Print& output) const
+	{
+		BufferedPrint<> p(output);
+
+		if(header) {
+			printHeader(p);
+		}
+
+		constexpr size_t batchRows = std::max(size_t(1), FSTR_CSV_BATCH_SIZE / sizeof(RowType));
+		RowType rows[batchRows];
+		unsigned rowCount = array.length();
+		for(unsigned i = 0; i < rowCount;) {
+			auto n = array.read(i, rows, std::min(batchRows, size_t(rowCount - i)));
+			if(n == 0) {
+				break;
+			}
+			for(unsigned j = 0; j < n; ++j) {
+				printRow(p, rows[j]);
+			}
+			i += n;
+		}
+
+		p.flush();
+		return p.getOutputLength();
+	}
+
+private:
+	const ArrayType& array;
+	const CsvColumn* columns{nullptr};
+	PrintFormat format;
+	unsigned columnCount;
+	FieldPrinter fieldPrinter;
+	char delimiter{','};
+	bool header{false};
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,175 @@
+/****
+ * CsvStream.hpp - Stream arrays of table rows or structures as CSV
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "CsvPrinter.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+/**
+ * @brief Stream providing CSV output
+ * @ingroup fstr_csv
+ * @tparam RowType Array element type
+ *
+ * Constructor arguments are as for CsvPrinter. Output is generated on demand, one line at a time,
+ * so RAM usage does not depend on the size of the table.
+ * The total length is calculated on construction so may be used for `Content-Length`.
+ *
+ * Example:
+ *
+ * 		auto stream = new FSTR::CsvStream<FloatRow>(table, columns, ARRAY_SIZE(columns));
+ * 		response.sendDataStream(stream, MIME_CSV);
+ */
+template <typename RowType> class CsvStream : public IDataSourceStream
+{
+public:
+	template <typename... Args> CsvStream(const Args&... args) : printer(args...)
+	{
+		for(unsigned i = 0; i < printer.lineCount(); ++i) {
+			length += lineLength(i);
+		}
+	}
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	int available() override
+	{
+		return int(length - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override
+	{
+		size_t size = std::min(size_t(std::max(bufSize, 0)), size_t(UINT16_MAX));
+		size_t count = 0;
+		unsigned line = currentLine;
+		size_t offset = lineOffset;
+		while(count < size && line < printer.lineCount()) {
+			WindowPrint window(data + count, size - count, offset);
+			auto len = printer.printLine(window, line);
+			count += window.used;
+			if(offset + window.used < len) {
+				break;
+			}
+			++line;
+			offset = 0;
+		}
+		return count;
+	}
+
+	int seekFrom(int offset, SeekOrigin origin) override
+	{
+		size_t newPos;
+		switch(origin) {
+		case SeekOrigin::Start:
+			newPos = offset;
+			break;
+		case SeekOrigin::Current:
+			newPos = readPos + offset;
+			break;
+		case SeekOrigin::End:
+			newPos = length + offset;
+			break;
+		default:
+			return -1;
+		}
+
+		if(newPos > length) {
+			return -1;
+		}
+
+		if(newPos < readPos) {
+			currentLine = 0;
+			lineOffset = 0;
+			readPos = 0;
+		}
+		while(readPos < newPos) {
+			auto remain = lineLength(currentLine) - lineOffset;
+			auto diff = newPos - readPos;
+			if(diff < remain) {
+				lineOffset += diff;
+				readPos = newPos;
+				break;
+			}
+			readPos += remain;
+			++currentLine;
+			lineOffset = 0;
+		}
+		return readPos;
+	}
+
+	bool isFinished() override
+	{
+		return readPos >= length;
+	}
+
+private:
+	/*
+	 * Captures a section of printed output
+	 */
+	class WindowPrint : public Print
+	{
+	public:
+		WindowPrint(char* buffer, size_t size, size_t skip) : buffer(buffer), size(size), skip(skip)
+		{
+		}
+
+		size_t write(uint8_t c) override
+		{
+			return write(&c, 1);
+		}
+
+		size_t write(const uint8_t* data, size_t len) override
+		{
+			auto n = std::min(skip, len);
+			skip -= n;
+			auto copyLen = std::min(len - n, size - used);
+			if(copyLen != 0) {
+				memcpy(buffer + used, data + n, copyLen);
+				used += copyLen;
+			}
+			return len;
+		}
+
+		using Print::write;
+
+		char* buffer;
+		size_t size;
+		size_t skip;
+		size_t used{0};
+	};
+
+	size_t lineLength(unsigned line) const
+	{
+		WindowPrint counter(nullptr, 0, 0);
+		return printer.printLine(counter, line);
+	}
+
+	CsvPrinter<RowType> printer;
+	size_t length{0};
+	size_t readPos{0};
+	unsigned currentLine{0};
+	size_t lineOffset{0};
+};
+
+} // namespace FSTR
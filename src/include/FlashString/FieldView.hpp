@@ -0,0 +1,245 @@
+/****
+ * FieldView.hpp - Access a single field within an Array of structures
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Utility.hpp"
+#include "ArrayPrinter.hpp"
+
+namespace FSTR
+{
+/**
+ * @brief Obtain structure and field types from a pointer to data member
+ */
+template <typename T> struct MemberPointer;
+
+template <class Class, typename Field> struct MemberPointer<Field Class::*> {
+	using RecordType = Class;
+	using FieldType = Field;
+};
+
+/**
+ * @brief View of one field in each element of an Array of structures
+ * @ingroup fstr_array
+ * @tparam Member Pointer to the data member, e.g. `&MyRecord::id`
+ *
+ * Only the words containing the field are read from flash, rather than copying each record in full.
+ * Where the field is suitably aligned in every record it is read using readValue(),
+ * otherwise using readUnaligned().
+ *
+ * Obtain using Array::project():
+ *
+ * 		auto ids = records.project<&MyRecord::id>();
+ * 		int index = ids.indexOf(12);
+ * 		auto maxId = ids.max();
+ */
+template <auto Member> class FieldView
+{
+public:
+	using RecordType = typename MemberPointer<decltype(Member)>::RecordType;
+	using FieldType = typename MemberPointer<decltype(Member)>::FieldType;
+
+	static_assert(!std::is_array<FieldType>::value, "Array fields not supported by FieldView");
+
+	class Iterator
+	{
+	public:
+		Iterator(const FieldView& view, unsigned index) : view(view), index(index)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &view == &rhs.view && index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		FieldType operator*() const
+		{
+			return view.unsafeValueAt(index);
+		}
+
+	private:
+		const FieldView& view;
+		unsigned index;
+	};
+
+	/**
+	 * @brief Get offset of the field within a record
+	 */
+	static size_t fieldOffset()
+	{
+		alignas(RecordType) uint8_t buffer[sizeof(RecordType)];
+		auto record = reinterpret_cast<const RecordType*>(buffer);
+		return reinterpret_cast<const uint8_t*>(&(record->*Member)) - buffer;
+	}
+
+	/**
+	 * @param records Pointer to Array data, which is word-aligned
+	 * @param length Number of records
+	 */
+	FieldView(const RecordType* records, size_t length)
+		: fields(reinterpret_cast<const uint8_t*>(records) + fieldOffset()), len(length)
+	{
+		constexpr size_t align = (sizeof(FieldType) >= 4) ? 4 : (sizeof(FieldType) >= 2) ? 2 : 1;
+		aligned = ((fieldOffset() | sizeof(RecordType)) & (align - 1)) == 0;
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, len);
+	}
+
+	/**
+	 * @brief Get number of records
+	 */
+	size_t length() const
+	{
+		return len;
+	}
+
+	/**
+	 * @brief Get the field value for a record
+	 * @retval FieldType Value-initialised if index is out of range
+	 */
+	FieldType valueAt(unsigned index) const
+	{
+		return (index < len) ? unsafeValueAt(index) : FieldType{};
+	}
+
+	FieldType operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	/**
+	 * @brief Find the first record with a matching field value
+	 * @param value Must be compatible with FieldType for equality comparison
+	 * @retval int Index of record, -1 if not found
+	 */
+	template <typename ValueType> int indexOf(const ValueType& value) const
+	{
+		for(unsigned i = 0; i < len; ++i) {
+			if(unsafeValueAt(i) == value) {
+				return int(i);
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * @brief Get the smallest field value
+	 * @retval FieldType Value-initialised if there are no records
+	 */
+	FieldType min() const
+	{
+		if(len == 0) {
+			return FieldType{};
+		}
+		auto result = unsafeValueAt(0);
+		for(unsigned i = 1; i < len; ++i) {
+			auto value = unsafeValueAt(i);
+			if(value < result) {
+				result = value;
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Get the largest field value
+	 * @retval FieldType Value-initialised if there are no records
+	 */
+	FieldType max() const
+	{
+		if(len == 0) {
+			return FieldType{};
+		}
+		auto result = unsafeValueAt(0);
+		for(unsigned i = 1; i < len; ++i) {
+			auto value = unsafeValueAt(i);
+			if(result < value) {
+				result = value;
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Extract field values into RAM
+	 * @param index First record to read
+	 * @param buffer Where to store values
+	 * @param count How many values to read
+	 * @retval size_t Number of values actually read
+	 */
+	size_t read(size_t index, FieldType* buffer, size_t count) const
+	{
+		if(index >= len) {
+			return 0;
+		}
+		count = std::min(count, len - index);
+		for(unsigned i = 0; i < count; ++i) {
+			buffer[i] = unsafeValueAt(index + i);
+		}
+		return count;
+	}
+
+	ArrayPrinter<FieldView> printer(const PrintFormat& format = {}) const
+	{
+		return ArrayPrinter<FieldView>(*this, format);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		return printer().printTo(p);
+	}
+
+	FieldType unsafeValueAt(unsigned index) const
+	{
+		auto ptr = reinterpret_cast<const FieldType*>(fields + index * sizeof(RecordType));
+		if(aligned) {
+			return readValue(ptr);
+		}
+		FieldType value;
+		readUnaligned(&value, ptr, sizeof(FieldType));
+		return value;
+	}
+
+private:
+	const uint8_t* fields; ///< Location of field in first record
+	size_t len;
+	bool aligned;
+};
+
+} // namespace FSTR
@@ -0,0 +1,232 @@
+/****
+ * FileMap.hpp - Read-only file system using imported content
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "PathIndex.hpp"
+#include "Stream.hpp"
+
+/**
+ * @defgroup fstr_file_map File Maps
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global File& reference
+ * @param name
+ */
+#define DECLARE_FSTR_FILE(name) DECLARE_FSTR_OBJECT(name, FSTR::File)
+
+/**
+ * @brief Define a File Object with global reference
+ * @param name Name of File& reference to define
+ * @param content String object containing file data
+ * @param mimeType String object containing the MIME type
+ * @param mtime Modification time, seconds since 1/1/1970 UTC
+ * @param etag Entity tag value
+ */
+#define DEFINE_FSTR_FILE(name, content, mimeType, mtime, etag)                                                         \
+	static DEFINE_FSTR_FILE_DATA(FSTR_DATA_NAME(name), content, mimeType, mtime, etag);                                \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_FILE except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_FILE_LOCAL(name, content, mimeType, mtime, etag)                                                   \
+	static DEFINE_FSTR_FILE_DATA(FSTR_DATA_NAME(name), content, mimeType, mtime, etag);                                \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a File data structure
+ */
+#define DEFINE_FSTR_FILE_DATA(name, content, mimeType, mtime, etag)                                                    \
+	constexpr const struct {                                                                                           \
+		FSTR::File object;                                                                                             \
+		FSTR::FileRecord data[1];                                                                                      \
+	} FSTR_PACKED name PROGMEM = {{sizeof(FSTR::FileRecord)}, {{&content, &mimeType, mtime, etag}}};                   \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Declare a global FileMap& reference
+ * @param name
+ */
+#define DECLARE_FSTR_FILE_MAP(name) DECLARE_FSTR_OBJECT(name, FSTR::FileMap)
+
+/**
+ * @brief Define a FileMap Object with global reference
+ * @param name Name of FileMap& reference to define
+ * @param ... List of entries { "path", &file }
+ * @note This is usually generated using `tools/filemap.py`
+ */
+#define DEFINE_FSTR_FILE_MAP(name, ...)                                                                                \
+	static DEFINE_FSTR_PATH_INDEX_DATA_TYPED(FSTR_DATA_NAME(name), FSTR::FileMap, __VA_ARGS__);                        \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_FILE_MAP except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_FILE_MAP_LOCAL(name, ...)                                                                          \
+	static DEFINE_FSTR_PATH_INDEX_DATA_TYPED(FSTR_DATA_NAME(name), FSTR::FileMap, __VA_ARGS__);                        \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+namespace FSTR
+{
+/**
+ * @brief File metadata
+ */
+struct FileRecord {
+	const String* content;
+	const String* mimeType;
+	uint32_t mtime; ///< Modification time, seconds since 1/1/1970 UTC
+	uint32_t etag;	///< Entity tag, generated from content
+};
+
+/**
+ * @brief A file entry with content and metadata
+ */
+class File : public Object<File, FileRecord>
+{
+public:
+	/**
+	 * @brief Get the file content
+	 */
+	const String& content() const
+	{
+		return deref(isNull() ? nullptr : readValue(&data()->content));
+	}
+
+	/**
+	 * @brief Get the file size in bytes
+	 */
+	size_t size() const
+	{
+		return content().length();
+	}
+
+	const String& mimeType() const
+	{
+		return deref(isNull() ? nullptr : readValue(&data()->mimeType));
+	}
+
+	/**
+	 * @brief Get the modification time, seconds since 1/1/1970 UTC
+	 */
+	uint32_t mtime() const
+	{
+		return isNull() ? 0 : readValue(&data()->mtime);
+	}
+
+	uint32_t etag() const
+	{
+		return isNull() ? 0 : readValue(&data()->etag);
+	}
+
+	/**
+	 * @brief Get the entity tag as a quoted string, suitable for use as an HTTP ETag
+	 * @param buffer Must have room for 11 characters
+	 * @retval const char* The buffer
+	 */
+	const char* getETag(char* buffer) const;
+
+private:
+	static const String& deref(const String* ptr)
+	{
+		return ptr ? *ptr : String::empty();
+	}
+} FSTR_PACKED;
+
+/**
+ * @brief Stream for reading file content
+ *
+ * Reports the file path as its name, so a MIME type can be determined from the extension.
+ * The ETag is provided as the stream ID.
+ */
+class FileStream : public Stream
+{
+public:
+	FileStream(const File& file, const String& path) : Stream(file.content()), file(file), path(path)
+	{
+	}
+
+	WString getName() const override
+	{
+		return path;
+	}
+
+	WString id() const override;
+
+	const File& getFile() const
+	{
+		return file;
+	}
+
+private:
+	const File& file;
+	const String& path;
+};
+
+/**
+ * @brief A read-only file system
+ *
+ * This is a PathIndex where each entry is a File. Lookups use a single hashed search.
+ */
+class FileMap : public PathIndex
+{
+public:
+	/**
+	 * @brief Get file information
+	 * @param path
+	 * @retval File& Check with isNull() if file doesn't exist
+	 */
+	template <typename... Args> const File& stat(const Args&... path) const
+	{
+		return resolve<File>(path...);
+	}
+
+	template <typename... Args> bool exists(const Args&... path) const
+	{
+		return indexOf(path...) >= 0;
+	}
+
+	/**
+	 * @brief Get a file by index
+	 */
+	const File& fileAt(unsigned index) const
+	{
+		auto obj = objectAt(index);
+		return obj ? obj->as<File>() : File::empty();
+	}
+
+	/**
+	 * @brief Open a file
+	 * @param path
+	 * @retval FileStream* nullptr if file doesn't exist. Caller must delete the stream when finished.
+	 */
+	template <typename... Args> FileStream* open(const Args&... path) const
+	{
+		return openIndex(indexOf(path...));
+	}
+
+	FileStream* openIndex(int index) const;
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
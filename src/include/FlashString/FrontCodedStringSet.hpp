@@ -0,0 +1,421 @@
+/****
+ * FrontCodedStringSet.hpp - Sorted set of strings stored using front coding
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "Print.hpp"
+#include <utility>
+
+/**
+ * @defgroup fstr_front_coded_set Front-coded String Sets
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global FrontCodedStringSet& reference
+ * @param name
+ * @note Use DEFINE_FSTR_FRONT_CODED_SET to instantiate the global object
+ */
+#define DECLARE_FSTR_FRONT_CODED_SET(name) DECLARE_FSTR_OBJECT(name, FSTR::FrontCodedStringSet)
+
+/**
+ * @brief Define a FrontCodedStringSet Object with global reference
+ * @param name Name of FrontCodedStringSet& reference to define
+ * @param ... List of quoted strings, in any order
+ * @note Strings are sorted and duplicates removed at compile time
+ */
+#define DEFINE_FSTR_FRONT_CODED_SET(name, ...)                                                                         \
+	static DEFINE_FSTR_FRONT_CODED_SET_DATA(FSTR_DATA_NAME(name), __VA_ARGS__);                                        \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_FRONT_CODED_SET except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_FRONT_CODED_SET_LOCAL(name, ...)                                                                   \
+	static DEFINE_FSTR_FRONT_CODED_SET_DATA(FSTR_DATA_NAME(name), __VA_ARGS__);                                        \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a FrontCodedStringSet data structure
+ * @param name Name of data structure
+ * @param ... List of quoted strings
+ *
+ * The string list is only used at compile time to build the structure.
+ */
+#define DEFINE_FSTR_FRONT_CODED_SET_DATA(name, ...)                                                                    \
+	constexpr const char* const FSTR_FRONT_CODED_SET_KEYS(name)[] = {__VA_ARGS__};                                     \
+	static constexpr const FSTR::FrontCodedStringSetData<FSTR::frontCodedSize(FSTR_FRONT_CODED_SET_KEYS(name))> name   \
+		PROGMEM = FSTR::makeFrontCodedStringSetData<FSTR::frontCodedSize(FSTR_FRONT_CODED_SET_KEYS(name))>(            \
+			FSTR_FRONT_CODED_SET_KEYS(name));                                                                          \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Provide internal name for the key list used to construct a FrontCodedStringSet
+ */
+#define FSTR_FRONT_CODED_SET_KEYS(name) FSTR_FRONT_CODED_SET_KEYS_(name)
+#define FSTR_FRONT_CODED_SET_KEYS_(name) name##_keys
+
+namespace FSTR
+{
+/**
+ * @brief A sorted set of strings stored using front coding
+ *
+ * Strings are stored in blocks of `blockSize`. The first string in each block is stored in full,
+ * subsequent strings as the length of the prefix shared with the previous string plus the remaining suffix.
+ * This substantially reduces storage where strings share long prefixes, such as file paths.
+ *
+ * Data layout:
+ *
+ * 		uint16_t count;						// Number of strings
+ * 		uint16_t blockCount;				// Number of blocks
+ * 		uint32_t blockOffsets[blockCount];	// Offset of each block from start of data
+ * 		Block blocks[blockCount];
+ *
+ * Each block contains:
+ *
+ * 		uint8_t length; char text[length];	// Block head
+ * 		{uint8_t prefix; uint8_t suffix; char text[suffix];} ...
+ *
+ * Lookups use a binary search on the block heads followed by a sequential decode within one block.
+ * Comparisons are case-sensitive and use byte ordering, as for `strcmp`.
+ */
+class FrontCodedStringSet : public Object<FrontCodedStringSet, uint8_t>
+{
+public:
+	static constexpr unsigned blockSize = 16;
+	static constexpr unsigned maxKeyLength = 255;
+	static constexpr unsigned headerSize = sizeof(uint16_t) * 2;
+
+	/**
+	 * @brief Iterator decodes each string in turn into an internal buffer
+	 */
+	class Iterator
+	{
+	public:
+		Iterator(const FrontCodedStringSet& set, unsigned index) : set(set), index_(index)
+		{
+			if(index_ < set.length()) {
+				offset = set.blockOffset(0);
+				decode();
+			}
+		}
+
+		Iterator& operator++()
+		{
+			++index_;
+			if(index_ < set.length()) {
+				decode();
+			}
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &set == &rhs.set && index_ == rhs.index_;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		/**
+		 * @brief Get the current string
+		 * @retval const char* NUL-terminated, valid until iterator is advanced
+		 */
+		const char* operator*() const
+		{
+			return buffer;
+		}
+
+		size_t length() const
+		{
+			return length_;
+		}
+
+		unsigned index() const
+		{
+			return index_;
+		}
+
+	private:
+		void decode()
+		{
+			offset = set.decode(index_, offset, buffer, length_);
+		}
+
+		const FrontCodedStringSet& set;
+		unsigned index_;
+		size_t offset{0};
+		uint8_t length_{0};
+		char buffer[maxKeyLength + 1]{};
+	};
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, length());
+	}
+
+	/**
+	 * @brief Get the number of strings in the set
+	 */
+	size_t length() const
+	{
+		return isNull() ? 0 : readHeader(0);
+	}
+
+	/**
+	 * @brief Get the number of blocks
+	 */
+	size_t blockCount() const
+	{
+		return isNull() ? 0 : readHeader(1);
+	}
+
+	/**
+	 * @brief Lookup a string
+	 * @param key
+	 * @param keyLength
+	 * @retval int Index of string in sorted order, -1 if not found
+	 */
+	int indexOf(const char* key, size_t keyLength) const;
+
+	int indexOf(const char* key) const
+	{
+		return (key == nullptr) ? -1 : indexOf(key, strlen(key));
+	}
+
+	/**
+	 * @brief Lookup a Wiring String or other type providing `c_str()` and `length()`
+	 */
+	template <typename T> int indexOf(const T& key) const
+	{
+		return indexOf(key.c_str(), key.length());
+	}
+
+	template <typename T> bool contains(const T& key) const
+	{
+		return indexOf(key) >= 0;
+	}
+
+	/**
+	 * @brief Decode a string by index
+	 * @param index
+	 * @param buffer Must have room for `maxKeyLength + 1` characters
+	 * @retval size_t Length of string, 0 if index is out of range
+	 */
+	size_t valueAt(unsigned index, char* buffer) const;
+
+	/* Arduino Print support */
+
+	size_t printTo(Print& p) const;
+
+	/**
+	 * @brief Decode string following the one at `offset`
+	 * @param index Index of the string to decode
+	 * @param offset Offset of the string in the data
+	 * @param buffer Contains the previous string, on return contains the decoded string
+	 * @param length On return, contains length of decoded string
+	 * @retval size_t Offset of the following string
+	 */
+	size_t decode(unsigned index, size_t offset, char* buffer, uint8_t& length) const;
+
+private:
+	uint16_t readHeader(unsigned index) const
+	{
+		return readValue(reinterpret_cast<const uint16_t*>(ObjectBase::data()) + index);
+	}
+
+	uint32_t blockOffset(unsigned block) const
+	{
+		return readValue(reinterpret_cast<const uint32_t*>(ObjectBase::data() + headerSize) + block);
+	}
+
+	/*
+	 * Compare a key with the head of a block
+	 */
+	int compareHead(unsigned block, const char* key, size_t keyLength) const;
+};
+
+/**
+ * @brief Structure of a FrontCodedStringSet
+ * @tparam Size Number of bytes of encoded data
+ */
+template <size_t Size> struct FrontCodedStringSetData {
+	FrontCodedStringSet object;
+	uint8_t data[ALIGNUP4(Size)];
+} FSTR_PACKED;
+
+/**
+ * @name Compile-time helper functions used to construct FrontCodedStringSetData
+ * @{
+ */
+
+constexpr size_t frontCodedLength(const char* s)
+{
+	size_t len = 0;
+	while(s[len] != '\0') {
+		++len;
+	}
+	return len;
+}
+
+constexpr int frontCodedCompare(const char* a, const char* b)
+{
+	for(;; ++a, ++b) {
+		if(*a != *b || *a == '\0') {
+			return int(uint8_t(*a)) - int(uint8_t(*b));
+		}
+	}
+}
+
+constexpr size_t frontCodedPrefix(const char* a, const char* b)
+{
+	size_t len = 0;
+	while(a[len] != '\0' && a[len] == b[len] && len < 255) {
+		++len;
+	}
+	return len;
+}
+
+template <size_t Count> struct FrontCodedKeyList {
+	const char* keys[Count];
+	size_t count;
+};
+
+/**
+ * @brief Sort keys and remove duplicates
+ */
+template <size_t Count> constexpr FrontCodedKeyList<Count> frontCodedSort(const char* const (&keys)[Count])
+{
+	FrontCodedKeyList<Count> list{};
+	for(auto key : keys) {
+		unsigned i = 0;
+		int cmp = 1;
+		while(i < list.count && (cmp = frontCodedCompare(list.keys[i], key)) < 0) {
+			++i;
+		}
+		if(i < list.count && cmp == 0) {
+			continue;
+		}
+		for(unsigned j = list.count; j > i; --j) {
+			list.keys[j] = list.keys[j - 1];
+		}
+		list.keys[i] = key;
+		++list.count;
+	}
+	return list;
+}
+
+/**
+ * @brief Not defined, so calling from a constexpr function causes a compile error
+ */
+void frontCodedStringTooLong();
+
+template <size_t Size> struct FrontCodedBuffer {
+	uint8_t data[Size ? Size : 1];
+	size_t length;
+
+	constexpr void add(uint8_t c)
+	{
+		if(length < Size) {
+			data[length] = c;
+		}
+		++length;
+	}
+
+	constexpr void add32(uint32_t value, size_t offset)
+	{
+		for(unsigned i = 0; i < 4; ++i) {
+			data[offset + i] = uint8_t(value >> (i * 8));
+		}
+	}
+};
+
+/**
+ * @brief Encode keys into buffer
+ * @note Called with a zero-sized buffer to obtain required size
+ */
+template <size_t Size, size_t Count>
+constexpr FrontCodedBuffer<Size> frontCodedEncode(const char* const (&keys)[Count])
+{
+	auto list = frontCodedSort(keys);
+	constexpr auto blockSize = FrontCodedStringSet::blockSize;
+	auto blockCount = (list.count + blockSize - 1) / blockSize;
+	FrontCodedBuffer<Size> buf{};
+	buf.add(uint8_t(list.count));
+	buf.add(uint8_t(list.count >> 8));
+	buf.add(uint8_t(blockCount));
+	buf.add(uint8_t(blockCount >> 8));
+	buf.length += blockCount * sizeof(uint32_t);
+	for(unsigned i = 0; i < list.count; ++i) {
+		auto key = list.keys[i];
+		auto len = frontCodedLength(key);
+		if(len > FrontCodedStringSet::maxKeyLength) {
+			frontCodedStringTooLong();
+		}
+		size_t prefix = 0;
+		if(i % blockSize == 0) {
+			if(Size != 0) {
+				buf.add32(buf.length, FrontCodedStringSet::headerSize + (i / blockSize) * sizeof(uint32_t));
+			}
+			buf.add(len);
+		} else {
+			prefix = frontCodedPrefix(key, list.keys[i - 1]);
+			buf.add(prefix);
+			buf.add(len - prefix);
+		}
+		for(auto j = prefix; j < len; ++j) {
+			buf.add(key[j]);
+		}
+	}
+	return buf;
+}
+
+template <size_t Count> constexpr size_t frontCodedSize(const char* const (&keys)[Count])
+{
+	return frontCodedEncode<0>(keys).length;
+}
+
+template <size_t Size, size_t... Indices>
+constexpr FrontCodedStringSetData<Size> makeFrontCodedStringSetData(const FrontCodedBuffer<ALIGNUP4(Size)>& buf,
+																	std::index_sequence<Indices...>)
+{
+	return {{Size}, {buf.data[Indices]...}};
+}
+
+template <size_t Size, size_t Count>
+constexpr FrontCodedStringSetData<Size> makeFrontCodedStringSetData(const char* const (&keys)[Count])
+{
+	return makeFrontCodedStringSetData<Size>(frontCodedEncode<ALIGNUP4(Size)>(keys),
+											 std::make_index_sequence<ALIGNUP4(Size)>());
+}
+
+/** @} */
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,104 @@
+/****
+ * Gzip.hpp - Support for gzip-compressed objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+
+class IDataSourceStream;
+
+/**
+ * @defgroup fstr_gzip Compressed objects
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global GzipObject& reference
+ * @param name
+ */
+#define DECLARE_FSTR_GZIP(name) DECLARE_FSTR_OBJECT(name, FSTR::GzipObject)
+
+/**
+ * @brief Bind a gzip-compressed file into the firmware image
+ * @param name Name of GzipObject& reference to define
+ * @param file Absolute path to the file, which must be in gzip format
+ * @note Use `tools/fstrgzip.py` to compress files with a reduced window size
+ */
+#define IMPORT_FSTR_GZIP(name, file) IMPORT_FSTR_OBJECT(name, FSTR::GzipObject, file)
+
+/**
+ * @brief Like IMPORT_FSTR_GZIP except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_GZIP_LOCAL(name, file) IMPORT_FSTR_OBJECT_LOCAL(name, FSTR::GzipObject, file)
+
+namespace FSTR
+{
+/**
+ * @brief Contains gzip-compressed data
+ *
+ * The object length is that of the compressed data.
+ * The uncompressed length is read from the gzip trailer so requires no additional storage.
+ */
+class GzipObject : public Object<GzipObject, uint8_t>
+{
+public:
+	static constexpr uint8_t defaultWindowBits = 15;
+
+	/**
+	 * @brief Determine if object contains valid gzip data
+	 * @note Checks header only
+	 */
+	bool isValid() const;
+
+	/**
+	 * @brief Get length of uncompressed data
+	 * @note Value is modulo 2^32
+	 */
+	size_t uncompressedLength() const;
+
+	/**
+	 * @brief Get offset of compressed data, following the header
+	 * @retval size_t 0 if header is invalid
+	 */
+	size_t payloadOffset() const;
+
+	/**
+	 * @brief Get compression window size used when compressing the data
+	 * @retval uint8_t Window size as a power of 2
+	 * @note If not specified in header returns default (32KB) window size
+	 */
+	uint8_t windowBits() const;
+
+	/**
+	 * @brief Create a stream for the content
+	 * @param acceptGzip true if client accepts `Content-Encoding: gzip`
+	 * @retval IDataSourceStream* Returns stream containing compressed data if acceptGzip is true,
+	 * otherwise a stream which decompresses content on demand.
+	 * Caller must delete the stream when finished.
+	 */
+	IDataSourceStream* createStream(bool acceptGzip) const;
+
+private:
+	bool parseHeader(size_t& offset, uint8_t& bits) const;
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,122 @@
+/****
+ * InflateStream.hpp - Stream for decompressing gzip objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Gzip.hpp"
+#include <Data/Stream/DataSourceStream.h>
+#include <memory>
+
+namespace FSTR
+{
+/**
+ * @brief Stream which decompresses a GzipObject on demand
+ * @ingroup fstr_gzip
+ *
+ * Decoded data is held in a circular buffer which also serves as the compression window,
+ * so RAM usage is set by the window size used when compressing the data.
+ * Use `tools/fstrgzip.py` to compress with a reduced window size.
+ *
+ * Seeking backwards beyond the window requires decoding to restart from the beginning.
+ */
+class InflateStream : public IDataSourceStream
+{
+public:
+	InflateStream(const GzipObject& object);
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	bool isValid() const override
+	{
+		return state != State::error;
+	}
+
+	int available() override
+	{
+		return isValid() ? int(object.uncompressedLength() - readPos) : -1;
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return !isValid() || readPos >= object.uncompressedLength();
+	}
+
+private:
+	enum class State {
+		blockHeader,
+		stored,
+		huffman,
+		done,
+		error,
+	};
+
+	/*
+	 * Canonical Huffman decoding table
+	 */
+	template <size_t Symbols> struct Tree {
+		uint16_t counts[16];
+		uint16_t symbols[Symbols];
+	};
+
+	void restart();
+	void decode(size_t required);
+	bool readBlockHeader();
+	bool readDynamicTrees();
+	void buildFixedTrees();
+	template <size_t Symbols> bool buildTree(Tree<Symbols>& tree, const uint8_t* lengths, unsigned count);
+	template <size_t Symbols> int decodeSymbol(const Tree<Symbols>& tree);
+	int readByte();
+	int readBits(unsigned count);
+	void put(uint8_t c)
+	{
+		window[writePos++ & windowMask] = c;
+	}
+	size_t pending() const
+	{
+		return writePos - readPos;
+	}
+
+	const GzipObject& object;
+	std::unique_ptr<uint8_t[]> window;
+	size_t windowMask{0};
+	size_t inPos{0};	///< Offset of next block of compressed data to read into inBuffer
+	size_t writePos{0}; ///< Total bytes decoded
+	size_t readPos{0};	///< Total bytes consumed
+	uint32_t bitBuffer{0};
+	uint8_t bitCount{0};
+	bool finalBlock{false};
+	State state{State::blockHeader};
+	uint16_t storedLength{0};
+	uint16_t matchLength{0};
+	uint16_t matchDistance{0};
+	uint8_t inBuffer[32];
+	uint8_t inBufferPos{0};
+	uint8_t inBufferLength{0};
+	Tree<288> literalTree;
+	Tree<30> distanceTree;
+};
+
+} // namespace FSTR
@@ -0,0 +1,384 @@
+/****
+ * InlineKeyMap.hpp - Defines the InlineKeyMap class template and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "MapPair.hpp"
+#include "MapPrinter.hpp"
+#include <utility>
+
+/**
+ * @defgroup fstr_inline_key_map Inline Key Maps
+ * @ingroup fstr_map
+ * @{
+ */
+
+/**
+ * @brief Declare a global InlineKeyMap& reference
+ * @param name Name of the InlineKeyMap& reference to define
+ * @param ContentType Object type to declare for content
+ * @note Use DEFINE_FSTR_INLINE_KEY_MAP to instantiate the global object
+ */
+#define DECLARE_FSTR_INLINE_KEY_MAP(name, ContentType) DECLARE_FSTR_OBJECT(name, FSTR::InlineKeyMap<ContentType>)
+
+/**
+ * @brief Define an InlineKeyMap Object with global reference
+ * @param name Name of the InlineKeyMap& reference to define
+ * @param ContentType Object type to declare for content
+ * @param ... List of entries { "key", &content }
+ *
+ * Example:
+ *
+ * 		DEFINE_FSTR_INLINE_KEY_MAP(fileMap, FSTR::String,
+ * 			{"index.html", &content1},
+ * 			{"favicon.ico", &content2},
+ * 		);
+ */
+#define DEFINE_FSTR_INLINE_KEY_MAP(name, ContentType, ...)                                                             \
+	static DEFINE_FSTR_INLINE_KEY_MAP_DATA(FSTR_DATA_NAME(name), ContentType, __VA_ARGS__);                            \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_INLINE_KEY_MAP except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_INLINE_KEY_MAP_LOCAL(name, ContentType, ...)                                                       \
+	static DEFINE_FSTR_INLINE_KEY_MAP_DATA(FSTR_DATA_NAME(name), ContentType, __VA_ARGS__);                            \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define an InlineKeyMap data structure
+ * @param name Name of data structure
+ * @param ContentType Object type to declare for content
+ * @param ... List of entries { "key", &content }
+ *
+ * The entry list is only used at compile time to build the structure.
+ */
+#define DEFINE_FSTR_INLINE_KEY_MAP_DATA(name, ContentType, ...)                                                        \
+	constexpr const FSTR::InlineKeyMapEntry<ContentType> FSTR_INLINE_KEY_MAP_ENTRIES(name)[] = {__VA_ARGS__};          \
+	static constexpr const FSTR::InlineKeyMapData<ContentType,                                                         \
+												  FSTR::inlineKeyMapSize(FSTR_INLINE_KEY_MAP_ENTRIES(name)),           \
+												  FSTR::inlineKeyMapKeyWords(FSTR_INLINE_KEY_MAP_ENTRIES(name))>       \
+		name PROGMEM = FSTR::makeInlineKeyMapData<ContentType,                                                         \
+												  FSTR::inlineKeyMapKeyWords(FSTR_INLINE_KEY_MAP_ENTRIES(name))>(      \
+			FSTR_INLINE_KEY_MAP_ENTRIES(name));                                                                        \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Provide internal name for the entry list used to construct an InlineKeyMap
+ */
+#define FSTR_INLINE_KEY_MAP_ENTRIES(name) FSTR_INLINE_KEY_MAP_ENTRIES_(name)
+#define FSTR_INLINE_KEY_MAP_ENTRIES_(name) name##_entries
+
+namespace FSTR
+{
+template <class ContentType> class InlineKeyMap;
+
+/**
+ * @brief Describes an entry when defining an InlineKeyMap
+ */
+template <class ContentType> struct InlineKeyMapEntry {
+	const char* key;
+	const ContentType* content;
+};
+
+/**
+ * @brief Structure of an InlineKeyMap
+ * @tparam ContentType
+ * @tparam Size Number of entries
+ * @tparam KeyWords Size of key region in words
+ *
+ * The key region immediately follows the content pointers and contains a String object
+ * for each key, in order: a length word followed by the NUL-terminated text, padded to a word boundary.
+ */
+template <class ContentType, size_t Size, size_t KeyWords> struct InlineKeyMapData {
+	InlineKeyMap<ContentType> object;
+	const ContentType* data[Size];
+	uint32_t keys[KeyWords];
+} FSTR_PACKED;
+
+/**
+ * @name Compile-time helper functions used to construct InlineKeyMapData
+ * @{
+ */
+
+constexpr size_t inlineKeyLength(const char* key)
+{
+	size_t len = 0;
+	while(key[len] != '\0') {
+		++len;
+	}
+	return len;
+}
+
+/**
+ * @brief Get number of words occupied by a key in the key region
+ */
+constexpr size_t inlineKeyWords(const char* key)
+{
+	return 1 + ALIGNUP4(inlineKeyLength(key) + 1) / sizeof(uint32_t);
+}
+
+template <class ContentType, size_t Size>
+constexpr size_t inlineKeyMapSize(const InlineKeyMapEntry<ContentType> (&)[Size])
+{
+	return Size;
+}
+
+template <class ContentType, size_t Size>
+constexpr size_t inlineKeyMapKeyWords(const InlineKeyMapEntry<ContentType> (&entries)[Size])
+{
+	size_t words = 0;
+	for(auto& e : entries) {
+		words += inlineKeyWords(e.key);
+	}
+	return words;
+}
+
+/**
+ * @brief Get a word of the key region, stored little-endian
+ */
+template <class ContentType, size_t Size>
+constexpr uint32_t inlineKeyMapKeyWord(const InlineKeyMapEntry<ContentType> (&entries)[Size], size_t index)
+{
+	for(auto& e : entries) {
+		auto words = inlineKeyWords(e.key);
+		if(index >= words) {
+			index -= words;
+			continue;
+		}
+		auto len = inlineKeyLength(e.key);
+		if(index == 0) {
+			return len;
+		}
+		uint32_t word = 0;
+		auto offset = (index - 1) * sizeof(uint32_t);
+		for(unsigned i = 0; i < sizeof(uint32_t) && offset + i < len; ++i) {
+			word |= uint32_t(uint8_t(e.key[offset + i])) << (i * 8);
+		}
+		return word;
+	}
+	return 0;
+}
+
+template <class ContentType, size_t Size, size_t KeyWords, size_t... Indices, size_t... KeyIndices>
+constexpr InlineKeyMapData<ContentType, Size, KeyWords>
+makeInlineKeyMapData(const InlineKeyMapEntry<ContentType> (&entries)[Size], std::index_sequence<Indices...>,
+					 std::index_sequence<KeyIndices...>)
+{
+	return {{sizeof(const ContentType*) * Size},
+			{entries[Indices].content...},
+			{inlineKeyMapKeyWord(entries, KeyIndices)...}};
+}
+
+template <class ContentType, size_t KeyWords, size_t Size>
+constexpr InlineKeyMapData<ContentType, Size, KeyWords>
+makeInlineKeyMapData(const InlineKeyMapEntry<ContentType> (&entries)[Size])
+{
+	return makeInlineKeyMapData<ContentType, Size, KeyWords>(entries, std::make_index_sequence<Size>(),
+															 std::make_index_sequence<KeyWords>());
+}
+
+/** @} */
+
+/**
+ * @brief Class template to access an associative map with String keys stored inline
+ * @tparam ContentType
+ *
+ * Keys are stored together in a single region following the content pointers,
+ * so a search reads flash sequentially instead of following a pointer for each key.
+ *
+ * Entries are returned as MapPair<String, ContentType> so can be used as for a regular Map.
+ * Note that `valueAt()` must step through the preceding keys so prefer iteration.
+ */
+template <class ContentType>
+class InlineKeyMap : public Object<InlineKeyMap<ContentType>, const ContentType*>
+{
+public:
+	using Pair = MapPair<String, ContentType>;
+
+	/**
+	 * @brief Iterator returns MapPair values, as for Map
+	 */
+	class Iterator
+	{
+	public:
+		Iterator(const InlineKeyMap& map, unsigned index) : map(map), index(index), key(map.firstKey())
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			key = nextKey(key);
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &map == &rhs.map && index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		const Pair operator*() const
+		{
+			return Pair{key, readValue(map.data() + index)};
+		}
+
+	private:
+		const InlineKeyMap& map;
+		unsigned index;
+		const String* key;
+	};
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, this->length());
+	}
+
+	/**
+	 * @brief Get a map entry by index, if it exists
+	 * @note Result validity can be checked using if()
+	 */
+	const Pair valueAt(unsigned index) const
+	{
+		if(index >= this->length()) {
+			return Pair::empty();
+		}
+
+		return Pair{keyAt(index), readValue(this->data() + index)};
+	}
+
+	/**
+	 * @brief Get pointer to key String by index
+	 * @note Caller must check index is valid
+	 */
+	const String* keyAt(unsigned index) const
+	{
+		auto key = firstKey();
+		while(index-- != 0) {
+			key = nextKey(key);
+		}
+		return key;
+	}
+
+	/**
+	 * @brief Lookup a key and return the index
+	 * @param key
+	 * @param ignoreCase Whether search is case-sensitive (default: true)
+	 * @retval int If key isn't found, return -1
+	 */
+	template <typename TRefKey> int indexOf(const TRefKey& key, bool ignoreCase = true) const
+	{
+		const String* k;
+		return find(key, ignoreCase, k);
+	}
+
+	/**
+	 * @brief Lookup a key and return the entry, if found
+	 * @param key
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> const Pair operator[](const TRefKey& key) const
+	{
+		const String* k;
+		int i = find(key, true, k);
+		return (i < 0) ? Pair::empty() : Pair{k, readValue(this->data() + i)};
+	}
+
+	/* Arduino Print support */
+
+	/**
+	 * @brief Returns a printer object for this map
+	 * @note ElementType must be supported by Print
+	 */
+	MapPrinter<InlineKeyMap> printer(const PrintFormat& format = PrintFormat::forMap()) const
+	{
+		return MapPrinter<InlineKeyMap>(*this, format);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		return printer().printTo(p);
+	}
+
+	/**
+	 * @brief Get pointer to the first key String
+	 */
+	const String* firstKey() const
+	{
+		return reinterpret_cast<const String*>(ObjectBase::data() + ObjectBase::length());
+	}
+
+	/**
+	 * @brief Get pointer to the key String following the given key
+	 * @note Caller must ensure key is not the last one
+	 */
+	static const String* nextKey(const String* key)
+	{
+		return reinterpret_cast<const String*>(reinterpret_cast<const uint8_t*>(key) + sizeof(uint32_t) +
+											   key->size());
+	}
+
+	FSTR_INLINE static const ContentType& unsafeValueAt(const typename InlineKeyMap::DataPtrType dataptr,
+														unsigned index)
+	{
+		auto ptr = dataptr[index];
+		return ptr ? *ptr : ContentType::empty();
+	}
+
+private:
+	int find(const char* key, bool ignoreCase, const String*& k) const
+	{
+		auto keyLength = strlen(key);
+		return find([&](const String& s) { return s.equals(key, keyLength, ignoreCase); }, k);
+	}
+
+	template <typename TRefKey> int find(const TRefKey& key, bool ignoreCase, const String*& k) const
+	{
+		return find([&](const String& s) { return s.equals(key, ignoreCase); }, k);
+	}
+
+	template <typename Match> int find(Match match, const String*& k) const
+	{
+		auto len = this->length();
+		k = firstKey();
+		for(unsigned i = 0; i < len; ++i, k = nextKey(k)) {
+			if(match(*k)) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,256 @@
+/****
+ * JaggedArray.hpp - Array of variable-length rows stored in a single block
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Table.hpp"
+
+/**
+ * @defgroup fstr_jagged_array Jagged Arrays
+ * @ingroup fstr_table
+ * @{
+ */
+
+/**
+ * @brief Declare a global JaggedArray& reference
+ * @param name
+ * @param ElementType
+ * @note Use `DEFINE_FSTR_JAGGED_ARRAY` to instantiate the global Object
+ */
+#define DECLARE_FSTR_JAGGED_ARRAY(name, ElementType) DECLARE_FSTR_OBJECT(name, FSTR::JaggedArray<ElementType>)
+
+/**
+ * @brief Define a JaggedArray Object with global reference
+ * @param name Name of JaggedArray& reference to define
+ * @param ElementType
+ * @param rowLengths Parenthesised list giving the number of elements in each row
+ * @param ... List of ElementType items for all rows
+ *
+ * Example:
+ *
+ * 		DEFINE_FSTR_JAGGED_ARRAY(myArray, int, (3, 1, 2), 1, 2, 3, 4, 5, 6)
+ *
+ * Defines three rows, `{1, 2, 3}`, `{4}` and `{5, 6}`.
+ */
+#define DEFINE_FSTR_JAGGED_ARRAY(name, ElementType, rowLengths, ...)                                                   \
+	static DEFINE_FSTR_JAGGED_ARRAY_DATA(FSTR_DATA_NAME(name), ElementType, rowLengths, __VA_ARGS__);                  \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_JAGGED_ARRAY except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_JAGGED_ARRAY_LOCAL(name, ElementType, rowLengths, ...)                                             \
+	static DEFINE_FSTR_JAGGED_ARRAY_DATA(FSTR_DATA_NAME(name), ElementType, rowLengths, __VA_ARGS__);                  \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a JaggedArray data structure
+ * @param name Name of data structure
+ * @param ElementType
+ * @param rowLengths Parenthesised list giving the number of elements in each row
+ * @param ... List of ElementType items for all rows
+ */
+#define DEFINE_FSTR_JAGGED_ARRAY_DATA(name, ElementType, rowLengths, ...)                                              \
+	DEFINE_FSTR_JAGGED_ARRAY_DATA_SIZED(name, ElementType, FSTR_VA_NARGS(ElementType, __VA_ARGS__), rowLengths,        \
+										__VA_ARGS__)
+
+/**
+ * @brief Define a JaggedArray data structure, specifying the number of elements
+ * @param name Name of data structure
+ * @param ElementType
+ * @param size Total number of elements
+ * @param rowLengths Parenthesised list giving the number of elements in each row
+ * @param ... List of ElementType items for all rows
+ *
+ * Elements are padded to a word boundary and followed by the row index.
+ * The row length list is only used at compile time to build the index.
+ */
+#define DEFINE_FSTR_JAGGED_ARRAY_DATA_SIZED(name, ElementType, size, rowLengths, ...)                                  \
+	constexpr const uint32_t FSTR_JAGGED_ARRAY_ROWS(name)[] = {FSTR_UNPAREN rowLengths};                               \
+	static_assert(FSTR::jaggedArraySum(FSTR_JAGGED_ARRAY_ROWS(name)) == (size),                                        \
+				  "JaggedArray row lengths do not match number of elements");                                          \
+	static constexpr const struct {                                                                                    \
+		FSTR::JaggedArray<ElementType> object;                                                                         \
+		ElementType data[FSTR::JaggedArray<ElementType>::elementBlockCount(size)];                                     \
+		FSTR::JaggedArrayIndex<FSTR_VA_NARGS(uint32_t, FSTR_UNPAREN rowLengths)> index;                                \
+	} FSTR_PACKED name PROGMEM = {{sizeof(ElementType) * (size)},                                                      \
+								  {__VA_ARGS__},                                                                       \
+								  FSTR::makeJaggedArrayIndex(FSTR_JAGGED_ARRAY_ROWS(name))};                           \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Provide internal name for the row length list used to construct a JaggedArray
+ */
+#define FSTR_JAGGED_ARRAY_ROWS(name) FSTR_JAGGED_ARRAY_ROWS_(name)
+#define FSTR_JAGGED_ARRAY_ROWS_(name) name##_rows
+
+namespace FSTR
+{
+/**
+ * @brief Row index for a JaggedArray
+ * @tparam Rows Number of rows
+ */
+template <size_t Rows> struct JaggedArrayIndex {
+	uint32_t rowCount;
+	uint32_t rowEnd[Rows]; ///< Index of element following each row
+};
+
+/**
+ * @name Compile-time helper functions used to construct JaggedArray data
+ * @{
+ */
+
+template <size_t Rows> constexpr size_t jaggedArraySum(const uint32_t (&rowLengths)[Rows])
+{
+	size_t sum = 0;
+	for(size_t i = 0; i < Rows; ++i) {
+		sum += rowLengths[i];
+	}
+	return sum;
+}
+
+template <size_t Rows> constexpr JaggedArrayIndex<Rows> makeJaggedArrayIndex(const uint32_t (&rowLengths)[Rows])
+{
+	JaggedArrayIndex<Rows> index{Rows, {}};
+	uint32_t pos = 0;
+	for(size_t i = 0; i < Rows; ++i) {
+		pos += rowLengths[i];
+		index.rowEnd[i] = pos;
+	}
+	return index;
+}
+
+/** @} */
+
+/**
+ * @brief Class template to access an array of variable-length rows
+ * @tparam ElementType
+ *
+ * A Vector of Arrays stores each row as a separate object with its own length and padding,
+ * plus a pointer for each row. Here all elements are stored contiguously in a single object,
+ * followed by a table giving the end of each row.
+ *
+ * The Object interface, such as iteration and `length()`, operates on all elements in sequence.
+ * Use `row()` to access an individual row, or `readRow()` to copy one into RAM.
+ */
+template <typename ElementType> class JaggedArray : public Object<JaggedArray<ElementType>, ElementType>
+{
+public:
+	static_assert(!std::is_pointer<ElementType>::value, "Pointer types not supported by JaggedArray - use Vector");
+
+	using Row = TableSlice<ElementType>;
+
+	/**
+	 * @brief Get number of elements to allocate, including padding to word boundary
+	 * @note Count is rounded up so the block occupies a whole number of words,
+	 * e.g. a multiple of 4 elements for 3-byte types.
+	 */
+	static constexpr size_t elementBlockCount(size_t count)
+	{
+		constexpr size_t step = (sizeof(ElementType) % 4 == 0) ? 1 : (sizeof(ElementType) % 2 == 0) ? 2 : 4;
+		return (count + step - 1) / step * step;
+	}
+
+	/**
+	 * @brief Get number of rows
+	 */
+	size_t rows() const
+	{
+		return this->isNull() ? 0 : readValue(&rowIndex()[0]);
+	}
+
+	/**
+	 * @brief Get index of first element in a row
+	 * @retval size_t Total number of elements if row is out of range
+	 */
+	size_t rowStart(size_t row) const
+	{
+		if(row == 0) {
+			return 0;
+		}
+		return (row <= rows()) ? readValue(&rowIndex()[row]) : this->length();
+	}
+
+	/**
+	 * @brief Get number of elements in a row
+	 * @retval size_t 0 if row is out of range
+	 */
+	size_t rowLength(size_t row) const
+	{
+		return (row < rows()) ? readValue(&rowIndex()[row + 1]) - rowStart(row) : 0;
+	}
+
+	/**
+	 * @brief Get a view of a row
+	 * @retval Row Empty if row is out of range
+	 */
+	Row row(size_t row) const
+	{
+		if(row >= rows()) {
+			return Row(nullptr, 0, 1);
+		}
+		auto start = rowStart(row);
+		return Row(this->data() + start, readValue(&rowIndex()[row + 1]) - start, 1);
+	}
+
+	/**
+	 * @brief Read a row into RAM
+	 * @param row
+	 * @param buffer Where to store data
+	 * @param count Maximum number of elements to read
+	 * @retval size_t Number of elements actually read, 0 if row is out of range
+	 */
+	size_t readRow(size_t row, ElementType* buffer, size_t count) const
+	{
+		count = std::min(count, rowLength(row));
+		return (count == 0) ? 0 : this->read(rowStart(row), buffer, count);
+	}
+
+	/**
+	 * @brief Print array as a list of rows
+	 */
+	size_t printTo(Print& output) const
+	{
+		BufferedPrint<> p(output);
+		PrintFormat format;
+		format.printStart(p);
+		auto rowCount = rows();
+		for(unsigned i = 0; i < rowCount; ++i) {
+			format.printSeparator(p, i);
+			row(i).printTo(p);
+		}
+		format.printEnd(p);
+		p.flush();
+		return p.getOutputLength();
+	}
+
+private:
+	/*
+	 * Index follows element data. First entry is the row count, then the end of each row.
+	 */
+	const uint32_t* rowIndex() const
+	{
+		auto ptr = this->data() + elementBlockCount(this->length());
+		return reinterpret_cast<const uint32_t*>(ptr);
+	}
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,85 @@
+/****
+ * Json.hpp - Serialize objects as JSON directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Serialize.hpp"
+
+/**
+ * @defgroup fstr_json JSON
+ * @ingroup fstr_serialize
+ * @{
+ */
+
+namespace FSTR
+{
+/**
+ * @brief Generates JSON text for an object on demand
+ *
+ * String content is read from flash and escaped in chunks.
+ * Non-finite floating-point values are output as `null`.
+ */
+class JsonGenerator : public Serialize::Generator
+{
+public:
+	template <class ObjectType> JsonGenerator(const ObjectType& object) : Generator(object)
+	{
+	}
+
+protected:
+	void step() override;
+
+private:
+	void stepString(Frame& frame);
+	void emitValue(const Serialize::Value& value);
+	void emitScalar(const Serialize::Value& value);
+};
+
+/**
+ * @brief Print an object as JSON
+ *
+ * Example:
+ *
+ * 		Serial.print(FSTR::JsonPrinter(myMap));
+ */
+class JsonPrinter
+{
+public:
+	template <class ObjectType> JsonPrinter(const ObjectType& object) : generator(object)
+	{
+	}
+
+	/**
+	 * @brief Get the length of the output
+	 */
+	size_t length() const
+	{
+		JsonGenerator gen(generator);
+		return gen.measure();
+	}
+
+	size_t printTo(Print& p) const;
+
+private:
+	JsonGenerator generator;
+};
+
+} // namespace FSTR
+
+/** @} */
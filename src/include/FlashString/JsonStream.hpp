@@ -0,0 +1,42 @@
+/****
+ * JsonStream.hpp - Stream providing objects serialized as JSON
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Json.hpp"
+#include "SerializeStream.hpp"
+
+namespace FSTR
+{
+/**
+ * @brief Stream providing an object serialized as JSON
+ * @ingroup fstr_json
+ *
+ * Example:
+ *
+ * 		auto stream = new FSTR::JsonStream(myMap);
+ * 		response.sendDataStream(stream, MIME_JSON);
+ */
+class JsonStream : public Serialize::GeneratorStream<JsonGenerator>
+{
+public:
+	using GeneratorStream::GeneratorStream;
+};
+
+} // namespace FSTR
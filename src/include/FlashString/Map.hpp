@@ -134,12 +134,12 @@ public:
 	}
 
 	/**
-	 * @brief Lookup an integral key and return the index
+	 * @brief Lookup an integral or composite key and return the index
 	 * @param key Key to locate, must be compatible with KeyType for equality comparison
 	 * @retval int If key isn't found, return -1
 	 */
 	template <typename TRefKey, typename T = KeyType>
-	typename std::enable_if<!std::is_class<T>::value, int>::type indexOf(const TRefKey& key) const
+	typename std::enable_if<!std::is_same<T, String>::value, int>::type indexOf(const TRefKey& key) const
 	{
 		auto p = this->data();
 		auto len = this->length();
@@ -177,6 +177,31 @@ public:
 		return -1;
 	}
 
+	/**
+	 * @brief Lookup content and return the index of the first matching entry
+	 * @param content Object to locate, compared by address first and then by value
+	 * @retval int If content isn't found, return -1
+	 * @note This is a linear search: use MapReverseIndex for repeated lookups on larger maps
+	 */
+	int indexOfContent(const ContentType& content) const
+	{
+		auto p = this->data();
+		auto len = this->length();
+		for(unsigned i = 0; i < len; ++i) {
+			if(p[i].content_ == &content) {
+				return i;
+			}
+		}
+		for(unsigned i = 0; i < len; ++i) {
+			auto ptr = p[i].content_;
+			if(ptr != nullptr && *ptr == content) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
 	/**
 	 * @brief Lookup a key and return the entry, if found
 	 * @param key
@@ -193,9 +218,9 @@ public:
 	 * @brief Returns a printer object for this array
 	 * @note ElementType must be supported by Print
 	 */
-	MapPrinter<Map> printer() const
+	MapPrinter<Map> printer(const PrintFormat& format = PrintFormat::forMap()) const
 	{
-		return MapPrinter<Map>(*this);
+		return MapPrinter<Map>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
@@ -30,7 +30,7 @@ namespace FSTR
 /**
  * @brief describes a pair mapping key => data for a specified key type
  * @ingroup fstr_map
- * @tparam KeyType Integral, floating point, enum or String
+ * @tparam KeyType Integral, floating point, enum, String or composite key structure
  * @tparam ContentType Object type to use for content
  */
 template <typename KeyType, class ContentType> class MapPair
@@ -56,7 +56,7 @@ public:
 	 */
 	static const MapPair empty()
 	{
-		return MapPair{KeyStoreType(0), nullptr};
+		return MapPair{KeyStoreType{}, nullptr};
 	}
 
 	/**
@@ -68,6 +68,15 @@ public:
 		return readValue<KeyType>(&key_);
 	}
 
+	/**
+	 * @brief Get the key (composite key type)
+	 */
+	template <typename T = KeyType>
+	typename std::enable_if<std::is_class<T>::value && !std::is_same<T, String>::value, KeyType>::type key() const
+	{
+		return readValue<KeyType>(&key_);
+	}
+
 	/**
 	 * @brief Get the key (String key type)
 	 */
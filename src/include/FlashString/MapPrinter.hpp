@@ -19,38 +19,70 @@
 
 #pragma once
 
-#include "Print.hpp"
+#include "PrintFormat.hpp"
+#include "BufferedPrint.hpp"
 
 namespace FSTR
 {
 /**
  * @brief Class template to provide a simple way to print the contents of a Map
  * @note Used by Map::printTo() method
+ *
+ * Output is collected in a BufferedPrint staging buffer to minimise write calls.
+ * Layout and number formatting may be customised using a PrintFormat.
  */
 template <class MapType> class MapPrinter
 {
 public:
-	MapPrinter(const MapType& map) : map(map)
+	MapPrinter(const MapType& map, const PrintFormat& format = PrintFormat::forMap()) : map(map), format(format)
 	{
 	}
 
-	size_t printTo(Print& p) const
+	size_t printTo(Print& output) const
 	{
-		size_t count = 0;
+		BufferedPrint<> p(output);
 
-		count += p.println("{");
-		for(unsigned i = 0; i < map.length(); ++i) {
-			count += p.print("  ");
-			count += map.valueAt(i).printTo(p);
-			count += p.println();
+		format.printStart(p);
+		unsigned index = 0;
+		for(auto pair : map) {
+			format.printSeparator(p, index++);
+			if(pair) {
+				printKey(p, pair.key());
+				p.print(format.keySeparator);
+				printElement(p, pair.content(), format);
+			} else {
+				p.print(_F("(invalid)"));
+			}
 		}
-		count += p.print("}");
+		format.printEnd(p);
 
-		return count;
+		p.flush();
+		return p.getOutputLength();
 	}
 
 private:
+	template <typename T> size_t printKey(Print& p, const T& key) const
+	{
+		return printElement(p, key, format);
+	}
+
+	/*
+	 * Character keys are printed as-is, not as escaped character literals,
+	 * enclosed in quotes only if the format specifies them
+	 */
+	size_t printKey(Print& p, char key) const
+	{
+		if(format.quote == '\0') {
+			return p.print(key);
+		}
+		size_t count = p.print(format.quote);
+		count += p.print(key);
+		count += p.print(format.quote);
+		return count;
+	}
+
 	const MapType& map;
+	PrintFormat format;
 };
 
 } // namespace FSTR
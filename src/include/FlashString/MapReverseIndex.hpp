@@ -0,0 +1,187 @@
+/****
+ * MapReverseIndex.hpp - Content to key lookup for Map objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Map.hpp"
+#include <algorithm>
+#include <memory>
+
+namespace FSTR
+{
+/**
+ * @brief Provides fast lookup of map entries by content
+ * @ingroup fstr_map
+ * @tparam MapType Map, ColumnarMap or InlineKeyMap
+ *
+ * Content addresses are not known until link time, and content hashes require reading the data,
+ * so the index cannot be generated with the map. Instead it is built in RAM when constructed.
+ *
+ * Lookups by content address are always available. If `hashContent` is set then content is
+ * also hashed so that lookups for equal content at a different location also succeed.
+ *
+ * RAM usage is 8 bytes per entry, plus 12 bytes per entry if hashing is enabled.
+ * Maps are limited to 65535 entries.
+ *
+ * Example:
+ *
+ * 		FSTR::MapReverseIndex<FSTR::Map<FSTR::String, FSTR::String>> index(fileMap, true);
+ * 		auto pair = index[someContent];
+ * 		if(pair) {
+ * 			Serial << "Content has key " << pair.key() << endl;
+ * 		}
+ */
+template <class MapType> class MapReverseIndex
+{
+public:
+	using Pair = decltype(std::declval<const MapType&>().valueAt(0));
+	using ContentType = typename std::remove_cv<
+		typename std::remove_reference<decltype(std::declval<const Pair&>().content())>::type>::type;
+
+	/**
+	 * @brief Build index for a map
+	 * @param map The map to index, must remain valid for the lifetime of this index
+	 * @param hashContent Set to allow lookups by value as well as by address
+	 */
+	MapReverseIndex(const MapType& map, bool hashContent = false) : map(map)
+	{
+		for(auto pair : map) {
+			if(pair.content_ != nullptr) {
+				++count;
+			}
+		}
+
+		byAddress.reset(new AddressEntry[count]);
+		if(hashContent) {
+			byHash.reset(new HashEntry[count]);
+		}
+
+		uint16_t index = 0;
+		unsigned n = 0;
+		for(auto pair : map) {
+			auto content = pair.content_;
+			if(content != nullptr) {
+				byAddress[n] = AddressEntry{content, index};
+				if(byHash) {
+					byHash[n] = HashEntry{content, content->hash(), index};
+				}
+				++n;
+			}
+			++index;
+		}
+
+		// Sorts are stable so the first of any duplicates is found
+		std::stable_sort(byAddress.get(), byAddress.get() + count);
+		if(byHash) {
+			std::stable_sort(byHash.get(), byHash.get() + count);
+		}
+	}
+
+	/**
+	 * @brief Get number of indexed (non-null) entries
+	 */
+	unsigned length() const
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Determine if content hashes are available for lookup by value
+	 */
+	bool hasHashes() const
+	{
+		return bool(byHash);
+	}
+
+	/**
+	 * @brief Lookup content and return the index of the map entry
+	 * @param content Object to locate, compared by address first and then by value if hashing is enabled
+	 * @retval int If content isn't found, return -1
+	 */
+	int indexOf(const ContentType& content) const
+	{
+		AddressEntry addrKey{&content, 0};
+		auto a = std::lower_bound(byAddress.get(), byAddress.get() + count, addrKey);
+		if(a != byAddress.get() + count && a->content == &content) {
+			return a->index;
+		}
+
+		if(!byHash) {
+			return -1;
+		}
+
+		HashEntry hashKey{nullptr, content.hash(), 0};
+		for(auto h = std::lower_bound(byHash.get(), byHash.get() + count, hashKey);
+			h != byHash.get() + count && h->hash == hashKey.hash; ++h) {
+			if(*h->content == content) {
+				return h->index;
+			}
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Lookup content and return the map entry, if found
+	 * @note Result validity can be checked using if()
+	 */
+	const Pair operator[](const ContentType& content) const
+	{
+		return map.valueAt(indexOf(content));
+	}
+
+	/**
+	 * @brief Lookup content and return the corresponding key
+	 * @note If content isn't found, returns a default (zero) key, or String::empty() for String keys.
+	 * Use `operator[]` to distinguish a missing entry from a zero key.
+	 */
+	decltype(auto) keyOf(const ContentType& content) const
+	{
+		return operator[](content).key();
+	}
+
+private:
+	struct AddressEntry {
+		const ContentType* content;
+		uint16_t index;
+
+		bool operator<(const AddressEntry& other) const
+		{
+			return uintptr_t(content) < uintptr_t(other.content);
+		}
+	};
+
+	struct HashEntry {
+		const ContentType* content;
+		uint32_t hash;
+		uint16_t index;
+
+		bool operator<(const HashEntry& other) const
+		{
+			return hash < other.hash;
+		}
+	};
+
+	const MapType& map;
+	unsigned count{0};
+	std::unique_ptr<AddressEntry[]> byAddress;
+	std::unique_ptr<HashEntry[]> byHash;
+};
+
+} // namespace FSTR
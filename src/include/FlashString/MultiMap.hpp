@@ -0,0 +1,391 @@
+/****
+ * MultiMap.hpp - Defines the MultiMap class template and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "MapPair.hpp"
+#include "MapPrinter.hpp"
+#include <utility>
+
+/**
+ * @defgroup fstr_multi_map Multi-Maps
+ * @ingroup fstr_map
+ * @{
+ */
+
+/**
+ * @brief Declare a global MultiMap& reference
+ * @param name Name of the MultiMap& reference to define
+ * @param KeyType Integral, enum, floating-point or composite type to use for key
+ * @param ContentType Object type to declare for content
+ * @note Use DEFINE_FSTR_MULTI_MAP to instantiate the global object
+ */
+#define DECLARE_FSTR_MULTI_MAP(name, KeyType, ContentType)                                                             \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::MultiMap<KeyType, ContentType>)))
+
+/**
+ * @brief Define a MultiMap Object with global reference
+ * @param name Name of the MultiMap& reference to define
+ * @param KeyType Integral, enum, floating-point or composite type to use for key
+ * @param ContentType Object type to declare for content
+ * @param ... List of MapPair definitions { key, &content }, in any order
+ * @note Entries are sorted by key at compile time. Entries with equal keys retain their order.
+ */
+#define DEFINE_FSTR_MULTI_MAP(name, KeyType, ContentType, ...)                                                         \
+	static DEFINE_FSTR_MULTI_MAP_DATA(FSTR_DATA_NAME(name), KeyType, ContentType, __VA_ARGS__);                        \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_MULTI_MAP except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_MULTI_MAP_LOCAL(name, KeyType, ContentType, ...)                                                   \
+	static DEFINE_FSTR_MULTI_MAP_DATA(FSTR_DATA_NAME(name), KeyType, ContentType, __VA_ARGS__);                        \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a MultiMap data structure
+ * @param name Name of data structure
+ * @param KeyType Integral, enum, floating-point or composite type to use for key
+ * @param ContentType Object type to declare for content
+ * @param ... List of MapPair definitions { key, &content }
+ *
+ * The entry list is only used at compile time to build the structure.
+ */
+#define DEFINE_FSTR_MULTI_MAP_DATA(name, KeyType, ContentType, ...)                                                    \
+	constexpr const FSTR::MapPair<KeyType, ContentType> FSTR_MULTI_MAP_ENTRIES(name)[] = {__VA_ARGS__};                \
+	static constexpr const FSTR::MultiMapData<KeyType, ContentType,                                                    \
+											  FSTR::multiMapSize(FSTR_MULTI_MAP_ENTRIES(name))>                        \
+		name PROGMEM = FSTR::makeMultiMapData(FSTR_MULTI_MAP_ENTRIES(name));                                           \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Provide internal name for the entry list used to construct a MultiMap
+ */
+#define FSTR_MULTI_MAP_ENTRIES(name) FSTR_MULTI_MAP_ENTRIES_(name)
+#define FSTR_MULTI_MAP_ENTRIES_(name) name##_entries
+
+namespace FSTR
+{
+template <typename KeyType, class ContentType> class MultiMap;
+
+/**
+ * @brief Structure of a MultiMap
+ * @tparam KeyType
+ * @tparam ContentType
+ * @tparam Size Number of entries
+ */
+template <typename KeyType, class ContentType, size_t Size> struct MultiMapData {
+	MultiMap<KeyType, ContentType> object;
+	MapPair<KeyType, ContentType> data[Size];
+} FSTR_PACKED;
+
+/**
+ * @name Compile-time helper functions used to construct MultiMapData
+ * @{
+ */
+
+template <typename KeyType, class ContentType, size_t Size>
+constexpr size_t multiMapSize(const MapPair<KeyType, ContentType> (&)[Size])
+{
+	return Size;
+}
+
+template <typename KeyType, class ContentType, size_t Size> struct MultiMapEntries {
+	MapPair<KeyType, ContentType> pairs[Size];
+};
+
+/**
+ * @brief Sort entries by key, retaining order of entries with equal keys
+ */
+template <typename KeyType, class ContentType, size_t Size>
+constexpr MultiMapEntries<KeyType, ContentType, Size> multiMapSort(const MapPair<KeyType, ContentType> (&entries)[Size])
+{
+	MultiMapEntries<KeyType, ContentType, Size> sorted{};
+	for(size_t i = 0; i < Size; ++i) {
+		auto entry = entries[i];
+		auto j = i;
+		for(; j > 0 && entry.key_ < sorted.pairs[j - 1].key_; --j) {
+			sorted.pairs[j] = sorted.pairs[j - 1];
+		}
+		sorted.pairs[j] = entry;
+	}
+	return sorted;
+}
+
+template <typename KeyType, class ContentType, size_t Size, size_t... Indices>
+constexpr MultiMapData<KeyType, ContentType, Size>
+makeMultiMapData(const MultiMapEntries<KeyType, ContentType, Size>& sorted, std::index_sequence<Indices...>)
+{
+	return {{sizeof(MapPair<KeyType, ContentType>) * Size}, {sorted.pairs[Indices]...}};
+}
+
+template <typename KeyType, class ContentType, size_t Size>
+constexpr MultiMapData<KeyType, ContentType, Size>
+makeMultiMapData(const MapPair<KeyType, ContentType> (&entries)[Size])
+{
+	return makeMultiMapData(multiMapSort(entries), std::make_index_sequence<Size>());
+}
+
+/** @} */
+
+/**
+ * @brief Class template to access an associative map sorted by key, which may contain duplicate keys
+ * @tparam KeyType
+ * @tparam ContentType
+ *
+ * Entries are stored as for a Map, but sorted by key so lookups use a binary search.
+ * All entries for a key are adjacent and can be obtained using `equal_range()`.
+ *
+ * Composite keys must be trivially copyable structures with a constexpr `operator<`.
+ * Lookups use only `operator<`, so a partial key may be used to locate all entries sharing
+ * a prefix by providing comparisons in both directions:
+ *
+ * 		bool operator<(const RegisterKey& key, DeviceType device);
+ * 		bool operator<(DeviceType device, const RegisterKey& key);
+ */
+template <typename KeyType, class ContentType>
+class MultiMap : public Object<MultiMap<KeyType, ContentType>, MapPair<KeyType, ContentType>>
+{
+public:
+	using Pair = MapPair<KeyType, ContentType>;
+
+	/**
+	 * @brief Iterator returns MapPair values over a range of entries
+	 */
+	class Iterator
+	{
+	public:
+		Iterator(const MultiMap& map, unsigned index) : map(map), index(index)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &map == &rhs.map && index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		const Pair operator*() const
+		{
+			return map.valueAt(index);
+		}
+
+	private:
+		const MultiMap& map;
+		unsigned index;
+	};
+
+	/**
+	 * @brief A contiguous range of map entries
+	 */
+	class Range
+	{
+	public:
+		Range(const MultiMap& map, unsigned first, unsigned last) : map(map), first(first), last(last)
+		{
+		}
+
+		Iterator begin() const
+		{
+			return Iterator(map, first);
+		}
+
+		Iterator end() const
+		{
+			return Iterator(map, last);
+		}
+
+		/**
+		 * @brief Get number of entries in the range
+		 */
+		unsigned length() const
+		{
+			return last - first;
+		}
+
+		/**
+		 * @brief Get map index of first entry in the range
+		 */
+		unsigned index() const
+		{
+			return first;
+		}
+
+		/**
+		 * @brief Get an entry by index within the range, if it exists
+		 * @note Result validity can be checked using if()
+		 */
+		const Pair valueAt(unsigned index) const
+		{
+			return (index < length()) ? map.valueAt(first + index) : Pair::empty();
+		}
+
+		const Pair operator[](unsigned index) const
+		{
+			return valueAt(index);
+		}
+
+		explicit operator bool() const
+		{
+			return first != last;
+		}
+
+	private:
+		const MultiMap& map;
+		unsigned first;
+		unsigned last;
+	};
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, this->length());
+	}
+
+	/**
+	 * @brief Get a map entry by index, if it exists
+	 * @note Result validity can be checked using if()
+	 */
+	const Pair valueAt(unsigned index) const
+	{
+		if(index >= this->length()) {
+			return Pair::empty();
+		}
+
+		auto ptr = this->data() + index;
+		return Pair{readValue(&ptr->key_), readValue(&ptr->content_)};
+	}
+
+	/**
+	 * @brief Get index of first entry with a key not less than the given key
+	 * @retval unsigned Index of entry, or length() if there is none
+	 */
+	template <typename TRefKey> unsigned lower_bound(const TRefKey& key) const
+	{
+		return bound(key, [](const KeyType& k, const TRefKey& key) { return k < key; });
+	}
+
+	/**
+	 * @brief Get index of first entry with a key greater than the given key
+	 * @retval unsigned Index of entry, or length() if there is none
+	 */
+	template <typename TRefKey> unsigned upper_bound(const TRefKey& key) const
+	{
+		return bound(key, [](const KeyType& k, const TRefKey& key) { return !(key < k); });
+	}
+
+	/**
+	 * @brief Get the range of entries matching a key
+	 * @param key
+	 * @note Range is empty if the key isn't found
+	 */
+	template <typename TRefKey> Range equal_range(const TRefKey& key) const
+	{
+		auto first = lower_bound(key);
+		auto last = first;
+		auto len = this->length();
+		while(last < len && !(key < this->data()[last].key())) {
+			++last;
+		}
+		return Range(*this, first, last);
+	}
+
+	/**
+	 * @brief Get the number of entries matching a key
+	 */
+	template <typename TRefKey> unsigned count(const TRefKey& key) const
+	{
+		return upper_bound(key) - lower_bound(key);
+	}
+
+	/**
+	 * @brief Lookup a key and return the index of the first matching entry
+	 * @param key
+	 * @retval int If key isn't found, return -1
+	 */
+	template <typename TRefKey> int indexOf(const TRefKey& key) const
+	{
+		auto i = lower_bound(key);
+		return (i < this->length() && !(key < this->data()[i].key())) ? int(i) : -1;
+	}
+
+	/**
+	 * @brief Lookup a key and return the first matching entry, if found
+	 * @param key
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> const Pair operator[](const TRefKey& key) const
+	{
+		return valueAt(indexOf(key));
+	}
+
+	/* Arduino Print support */
+
+	/**
+	 * @brief Returns a printer object for this map
+	 * @note ElementType must be supported by Print
+	 */
+	MapPrinter<MultiMap> printer(const PrintFormat& format = PrintFormat::forMap()) const
+	{
+		return MapPrinter<MultiMap>(*this, format);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		return printer().printTo(p);
+	}
+
+private:
+	template <typename TRefKey, typename Compare> unsigned bound(const TRefKey& key, Compare before) const
+	{
+		auto p = this->data();
+		unsigned first = 0;
+		unsigned count = this->length();
+		while(count > 0) {
+			auto step = count / 2;
+			auto mid = first + step;
+			if(before(p[mid].key(), key)) {
+				first = mid + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+		return first;
+	}
+} FSTR_PACKED;
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,123 @@
+/****
+ * MultiStream.hpp - Stream presenting a list of objects as one
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "String.hpp"
+#include "Vector.hpp"
+#include <Data/Stream/DataSourceStream.h>
+#include <initializer_list>
+#include <memory>
+
+namespace FSTR
+{
+/**
+ * @brief Stream which concatenates the content of several objects
+ * @ingroup fstr_stream
+ *
+ * Useful for building responses from fragments such as a header, body and footer.
+ * A table of fragment start offsets is built on construction, so seeking uses a binary search.
+ * Reads may span several fragments.
+ *
+ * Objects must remain valid for the lifetime of the stream. As they're normally in flash this is not an issue.
+ */
+class MultiStream : public IDataSourceStream
+{
+public:
+	/**
+	 * @brief Construct a stream from a list of objects
+	 *
+	 * 		FSTR::MultiStream stream({&header, &content, &footer});
+	 */
+	MultiStream(std::initializer_list<const ObjectBase*> objects);
+
+	/**
+	 * @brief Construct a stream from the elements of a Vector
+	 * @note Null entries are treated as empty
+	 */
+	template <class ObjectType> MultiStream(const Vector<ObjectType>& vector)
+	{
+		auto len = vector.length();
+		if(init(len)) {
+			for(unsigned i = 0; i < len; ++i) {
+				add(i, vector.valueAt(i));
+			}
+		}
+	}
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	bool isValid() const override
+	{
+		return bool(fragments);
+	}
+
+	int available() override
+	{
+		return int(totalLength - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= totalLength;
+	}
+
+	/**
+	 * @brief Get number of fragments in the stream
+	 */
+	unsigned getFragmentCount() const
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Get index of fragment containing the given position
+	 * @retval unsigned Fragment index, or fragment count if position is beyond the end
+	 */
+	unsigned findFragment(size_t pos) const;
+
+private:
+	struct Fragment {
+		const ObjectBase* object;
+		size_t offset; ///< Start position within the stream
+	};
+
+	bool init(unsigned count);
+
+	void add(unsigned index, const ObjectBase& object)
+	{
+		fragments[index] = {&object, totalLength};
+		totalLength += object.length();
+	}
+
+	std::unique_ptr<Fragment[]> fragments;
+	unsigned count{0};
+	size_t totalLength{0};
+	size_t readPos{0};
+	unsigned current{0}; ///< Cached index of fragment containing readPos
+};
+
+} // namespace FSTR
@@ -89,6 +89,27 @@
 	extern "C" __attribute__((visibility("hidden"))) const ObjectType FSTR_DATA_NAME(name);                            \
 	static constexpr DEFINE_FSTR_OBJREF(name, FSTR_DATA_NAME(name))
 
+/**
+ * @brief Import an object from an external file, with a digest computed at build time
+ * @param name Name for the object
+ * @param ObjectType Object type for reference
+ * @param file Absolute path to the file containing the content
+ * @see See also `IMPORT_FSTR_DATA_DIGEST`
+ * @note The digest file must be generated before compiling using `tools/fstrdigest.py`
+ */
+#define IMPORT_FSTR_OBJECT_DIGEST(name, ObjectType, file)                                                              \
+	IMPORT_FSTR_DATA_DIGEST(FSTR_DATA_NAME(name), file)                                                                \
+	extern "C" __attribute__((visibility("hidden"))) const ObjectType FSTR_DATA_NAME(name);                            \
+	DEFINE_FSTR_OBJREF(name, FSTR_DATA_NAME(name))
+
+/**
+ * @brief Like IMPORT_FSTR_OBJECT_DIGEST except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_OBJECT_DIGEST_LOCAL(name, ObjectType, file)                                                        \
+	IMPORT_FSTR_DATA_DIGEST(FSTR_DATA_NAME(name), file)                                                                \
+	extern "C" __attribute__((visibility("hidden"))) const ObjectType FSTR_DATA_NAME(name);                            \
+	static constexpr DEFINE_FSTR_OBJREF(name, FSTR_DATA_NAME(name))
+
 namespace FSTR
 {
 /**
@@ -25,6 +25,15 @@
 
 namespace FSTR
 {
+/**
+ * @brief Digest values computed at build time for an imported object
+ * @see See `IMPORT_FSTR_OBJECT_DIGEST`
+ */
+struct ObjectDigest {
+	uint32_t crc32;		///< Standard CRC32 as used by zip, gzip, etc.
+	uint8_t sha256[32]; ///< SHA-256 hash
+};
+
 /**
  * @brief Used when defining data structures
  * @note Should not be used directly, use appropriate Object methods instead
@@ -37,7 +46,7 @@ public:
 	 */
 	FSTR_INLINE constexpr const size_t length() const
 	{
-		return flashLength_ & ~lengthInvalid;
+		return flashLength_ & ~(lengthInvalid | lengthDigest);
 	}
 
 	/**
@@ -92,6 +101,58 @@ public:
 	 */
 	size_t readFlash(size_t offset, void* buffer, size_t count) const;
 
+	/**
+	 * @brief Get a pointer for direct access to the object data, without copying
+	 * @param offset Zero-based offset from start of data
+	 * @param maxLen Maximum number of bytes required
+	 * @param length On success, number of bytes accessible via the returned pointer
+	 * @retval const uint8_t* nullptr if direct access is not supported or offset is out of range
+	 *
+	 * Data may be accessed directly on architectures where flash is memory-mapped and supports
+	 * byte access, such as Host, esp32 and rp2040. On the esp8266 this always returns nullptr
+	 * so callers must fall back to `read()` or `readFlash()`.
+	 */
+	const uint8_t* getDirectBuffer(size_t offset, size_t maxLen, size_t& length) const;
+
+	/**
+	 * @brief Calculate a hash of the object data
+	 * @retval uint32_t 32-bit FNV-1a hash value
+	 * @note Objects with equal content produce the same hash, regardless of location.
+	 * The whole object is read so this is relatively expensive for large objects.
+	 */
+	uint32_t hash() const;
+
+	/**
+	 * @brief Determine if object has a digest computed at build time
+	 */
+	FSTR_INLINE constexpr const bool hasDigest() const
+	{
+		return !isNull() && (flashLength_ & lengthDigest);
+	}
+
+	/**
+	 * @brief Get the digest computed at build time
+	 * @param digest On success, receives a copy of the digest
+	 * @retval bool false if object has no digest
+	 *
+	 * This requires no calculation, so is suitable for generating entity tags, etc.
+	 */
+	bool digest(ObjectDigest& digest) const;
+
+	/**
+	 * @brief Calculate CRC32 of the object data
+	 * @param crc Initial value, or result from previous call
+	 * @note Data is read using `readFlash()`
+	 */
+	uint32_t crc32(uint32_t crc = 0) const;
+
+	/**
+	 * @brief Check object content against the stored CRC32
+	 * @retval bool true if object has a digest and CRC matches
+	 * @note The whole object is read so this is relatively expensive for large objects
+	 */
+	bool verify() const;
+
 	/**
 	 * @brief Indicates an invalid String, used for return value from lookups, etc.
 	 * @note A real String can be zero-length, but it cannot be null
@@ -108,7 +169,8 @@ public:
 
 protected:
 	static const ObjectBase empty_;
-	static constexpr uint32_t lengthInvalid = 0x80000000U; ///< Indicates null string
+	static constexpr uint32_t lengthInvalid = 0x80000000U;		 ///< Indicates null string
+	static constexpr uint32_t lengthDigest = FSTR_LENGTH_DIGEST; ///< ObjectDigest follows data
 };
 
 } // namespace FSTR
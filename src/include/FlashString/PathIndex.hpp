@@ -0,0 +1,345 @@
+/****
+ * PathIndex.hpp - Defines the PathIndex class and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "String.hpp"
+#include <utility>
+
+/**
+ * @defgroup fstr_path_index Path Indexes
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global PathIndex& reference
+ * @param name
+ * @note Use DEFINE_FSTR_PATH_INDEX to instantiate the global object
+ */
+#define DECLARE_FSTR_PATH_INDEX(name) DECLARE_FSTR_OBJECT(name, FSTR::PathIndex)
+
+/**
+ * @brief Define a PathIndex Object with global reference
+ * @param name Name of PathIndex& reference to define
+ * @param ... List of entries { "path", &object }, in any order
+ *
+ * Example:
+ *
+ * 		DEFINE_FSTR_PATH_INDEX(configIndex,
+ * 			{"wifi/ssid", &ssid},
+ * 			{"wifi/channels", &channelArray},
+ * 		);
+ */
+#define DEFINE_FSTR_PATH_INDEX(name, ...)                                                                              \
+	static DEFINE_FSTR_PATH_INDEX_DATA(FSTR_DATA_NAME(name), __VA_ARGS__);                                             \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_PATH_INDEX except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_PATH_INDEX_LOCAL(name, ...)                                                                        \
+	static DEFINE_FSTR_PATH_INDEX_DATA(FSTR_DATA_NAME(name), __VA_ARGS__);                                             \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a PathIndex data structure
+ * @param name Name of data structure
+ * @param ... List of entries { "path", &object }
+ *
+ * The entry list is only used at compile time to build the structure.
+ */
+#define DEFINE_FSTR_PATH_INDEX_DATA(name, ...) DEFINE_FSTR_PATH_INDEX_DATA_TYPED(name, FSTR::PathIndex, __VA_ARGS__)
+
+/**
+ * @brief Define a data structure for a PathIndex or derived class
+ * @param name Name of data structure
+ * @param ObjectType PathIndex or class derived from it
+ * @param ... List of entries { "path", &object }
+ *
+ * The entry list is only used at compile time to build the structure.
+ */
+#define DEFINE_FSTR_PATH_INDEX_DATA_TYPED(name, ObjectType, ...)                                                       \
+	constexpr const FSTR::PathIndexEntry FSTR_PATH_INDEX_ENTRIES(name)[] = {__VA_ARGS__};                              \
+	static constexpr const FSTR::PathIndexData<ObjectType, FSTR::pathIndexSize(FSTR_PATH_INDEX_ENTRIES(name)),        \
+											   FSTR::pathIndexPathWords(FSTR_PATH_INDEX_ENTRIES(name))>                \
+		name PROGMEM = FSTR::makePathIndexData<ObjectType, FSTR::pathIndexPathWords(FSTR_PATH_INDEX_ENTRIES(name))>(  \
+			FSTR_PATH_INDEX_ENTRIES(name));                                                                            \
+	FSTR_CHECK_STRUCT(name);
+
+/**
+ * @brief Provide internal name for the entry list used to construct a PathIndex
+ */
+#define FSTR_PATH_INDEX_ENTRIES(name) FSTR_PATH_INDEX_ENTRIES_(name)
+#define FSTR_PATH_INDEX_ENTRIES_(name) name##_entries
+
+namespace FSTR
+{
+/**
+ * @brief Describes an entry when defining a PathIndex
+ */
+struct PathIndexEntry {
+	const char* path;
+	const ObjectBase* object;
+};
+
+/**
+ * @brief An entry in the PathIndex table
+ */
+struct PathIndexItem {
+	uint32_t hash;		 ///< Hash of path
+	uint32_t pathOffset; ///< Offset of path String from start of path region
+	const ObjectBase* object;
+};
+
+static_assert(sizeof(PathIndexItem) == 8 + sizeof(const ObjectBase*), "PathIndexItem must not contain padding");
+
+/**
+ * @brief Flattened index of objects within a nested structure, keyed by full path
+ *
+ * Instead of resolving a path such as "a/b/c" by searching each level of nested Maps and Vectors,
+ * all leaf objects are listed with their full path. The table is sorted by path hash at compile time,
+ * so `resolve()` performs a single binary search then confirms the match with one String comparison.
+ * No intermediate containers are accessed and no memory is allocated.
+ */
+class PathIndex : public Object<PathIndex, PathIndexItem>
+{
+public:
+	/**
+	 * @brief Lookup a path and return the index
+	 * @param path
+	 * @param pathLength
+	 * @retval int Index of entry, -1 if not found
+	 */
+	int indexOf(const char* path, size_t pathLength) const;
+
+	int indexOf(const char* path) const
+	{
+		return (path == nullptr) ? -1 : indexOf(path, strlen(path));
+	}
+
+	/**
+	 * @brief Lookup a Wiring String or other type providing `c_str()` and `length()`
+	 */
+	template <typename T> int indexOf(const T& path) const
+	{
+		return indexOf(path.c_str(), path.length());
+	}
+
+	/**
+	 * @brief Get the object for a path
+	 * @tparam ObjectType Type of object expected at the given path
+	 * @param path
+	 * @retval ObjectType& Check with isNull() if path may not exist
+	 */
+	template <class ObjectType, typename... Args> const ObjectType& resolve(const Args&... path) const
+	{
+		auto obj = objectAt(indexOf(path...));
+		return obj ? obj->template as<ObjectType>() : ObjectType::empty();
+	}
+
+	/**
+	 * @brief Get object pointer by index
+	 * @retval ObjectBase* nullptr if index is out of range
+	 */
+	const ObjectBase* objectAt(unsigned index) const
+	{
+		return (index < length()) ? readValue(&data()[index].object) : nullptr;
+	}
+
+	/**
+	 * @brief Get path by index
+	 * @note Entries are in order of path hash
+	 */
+	const String& pathAt(unsigned index) const
+	{
+		return (index < length()) ? *pathPtr(readValue(&data()[index].pathOffset)) : String::empty();
+	}
+
+private:
+	const String* pathPtr(uint32_t offset) const
+	{
+		return reinterpret_cast<const String*>(ObjectBase::data() + ObjectBase::length() + offset);
+	}
+} FSTR_PACKED;
+
+/**
+ * @brief Structure of a PathIndex
+ * @tparam ObjectType PathIndex or derived class
+ * @tparam Size Number of entries
+ * @tparam PathWords Size of path region in words
+ *
+ * Entries are sorted by path hash. The path region follows the entry table and contains
+ * a String object for each path, in the same order.
+ */
+template <class ObjectType, size_t Size, size_t PathWords> struct PathIndexData {
+	ObjectType object;
+	PathIndexItem data[Size];
+	uint32_t paths[PathWords];
+} FSTR_PACKED;
+
+/**
+ * @name Compile-time helper functions used to construct PathIndexData
+ * @{
+ */
+
+/**
+ * @brief Calculate hash for a path
+ * @note Same as ObjectBase::hash() for a String containing the path
+ */
+constexpr uint32_t pathHash(const char* path, size_t length)
+{
+	uint32_t hash = 2166136261U;
+	for(size_t i = 0; i < length; ++i) {
+		hash = (hash ^ uint8_t(path[i])) * 16777619U;
+	}
+	return hash;
+}
+
+constexpr size_t pathLength(const char* path)
+{
+	size_t len = 0;
+	while(path[len] != '\0') {
+		++len;
+	}
+	return len;
+}
+
+constexpr uint32_t pathHash(const char* path)
+{
+	return pathHash(path, pathLength(path));
+}
+
+/**
+ * @brief Get number of words occupied by a String object containing the path
+ */
+constexpr size_t pathWords(const char* path)
+{
+	return 1 + ALIGNUP4(pathLength(path) + 1) / sizeof(uint32_t);
+}
+
+template <size_t Size> constexpr size_t pathIndexSize(const PathIndexEntry (&)[Size])
+{
+	return Size;
+}
+
+template <size_t Size> constexpr size_t pathIndexPathWords(const PathIndexEntry (&entries)[Size])
+{
+	size_t words = 0;
+	for(auto& e : entries) {
+		words += pathWords(e.path);
+	}
+	return words;
+}
+
+template <size_t Size> struct PathIndexOrder {
+	uint16_t index[Size];
+};
+
+/**
+ * @brief Get entry order sorted by path hash
+ */
+template <size_t Size> constexpr PathIndexOrder<Size> pathIndexSort(const PathIndexEntry (&entries)[Size])
+{
+	PathIndexOrder<Size> order{};
+	for(size_t i = 0; i < Size; ++i) {
+		auto hash = pathHash(entries[i].path);
+		auto j = i;
+		for(; j > 0 && hash < pathHash(entries[order.index[j - 1]].path); --j) {
+			order.index[j] = order.index[j - 1];
+		}
+		order.index[j] = i;
+	}
+	return order;
+}
+
+/**
+ * @brief Get offset of a path String within the path region, in sorted order
+ */
+template <size_t Size>
+constexpr uint32_t pathIndexOffset(const PathIndexEntry (&entries)[Size], const PathIndexOrder<Size>& order,
+								   size_t pos)
+{
+	uint32_t offset = 0;
+	for(size_t i = 0; i < pos; ++i) {
+		offset += pathWords(entries[order.index[i]].path) * sizeof(uint32_t);
+	}
+	return offset;
+}
+
+/**
+ * @brief Get a word of the path region, stored little-endian
+ */
+template <size_t Size>
+constexpr uint32_t pathIndexPathWord(const PathIndexEntry (&entries)[Size], const PathIndexOrder<Size>& order,
+									 size_t index)
+{
+	for(size_t pos = 0; pos < Size; ++pos) {
+		auto path = entries[order.index[pos]].path;
+		auto words = pathWords(path);
+		if(index >= words) {
+			index -= words;
+			continue;
+		}
+		auto len = pathLength(path);
+		if(index == 0) {
+			return len;
+		}
+		uint32_t word = 0;
+		auto offset = (index - 1) * sizeof(uint32_t);
+		for(unsigned i = 0; i < sizeof(uint32_t) && offset + i < len; ++i) {
+			word |= uint32_t(uint8_t(path[offset + i])) << (i * 8);
+		}
+		return word;
+	}
+	return 0;
+}
+
+template <size_t Size>
+constexpr PathIndexItem pathIndexItem(const PathIndexEntry (&entries)[Size], const PathIndexOrder<Size>& order,
+									  size_t pos)
+{
+	return {pathHash(entries[order.index[pos]].path), pathIndexOffset(entries, order, pos),
+			entries[order.index[pos]].object};
+}
+
+template <class ObjectType, size_t Size, size_t PathWords, size_t... Indices, size_t... PathIndices>
+constexpr PathIndexData<ObjectType, Size, PathWords>
+makePathIndexData(const PathIndexEntry (&entries)[Size], const PathIndexOrder<Size>& order,
+				  std::index_sequence<Indices...>, std::index_sequence<PathIndices...>)
+{
+	return {{sizeof(PathIndexItem) * Size},
+			{pathIndexItem(entries, order, Indices)...},
+			{pathIndexPathWord(entries, order, PathIndices)...}};
+}
+
+template <class ObjectType, size_t PathWords, size_t Size>
+constexpr PathIndexData<ObjectType, Size, PathWords> makePathIndexData(const PathIndexEntry (&entries)[Size])
+{
+	return makePathIndexData<ObjectType, Size, PathWords>(entries, pathIndexSort(entries),
+														  std::make_index_sequence<Size>(),
+														  std::make_index_sequence<PathWords>());
+}
+
+/** @} */
+
+} // namespace FSTR
+
+/** @} */
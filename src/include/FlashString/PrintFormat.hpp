@@ -0,0 +1,180 @@
+/****
+ * PrintFormat.hpp - Formatting options for Array and Map printers
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Print.hpp"
+#include <type_traits>
+
+namespace FSTR
+{
+class String;
+
+/**
+ * @brief Describes how Array, Vector and Map printers lay out their content
+ * @ingroup fstr_print
+ *
+ * Default values give the regular Array output, `{1, 2, 3}`.
+ * Use `forMap()` to get the regular Map output, with one entry per line.
+ *
+ * For example, to print an array of bytes in hex, 16 per line:
+ *
+ * 		FSTR::PrintFormat format;
+ * 		format.radix = 16;
+ * 		format.width = 2;
+ * 		format.fill = '0';
+ * 		format.itemsPerLine = 16;
+ * 		format.indent = "  ";
+ * 		Serial.print(myArray.printer(format));
+ *
+ * Nested objects, such as the Arrays within a Vector, are printed using their default format.
+ * Text escaping is not performed.
+ */
+struct PrintFormat {
+	const char* prefix = "{";		   ///< Printed before the first item
+	const char* suffix = "}";		   ///< Printed after the last item
+	const char* separator = ", ";	  ///< Printed between items. Trailing spaces are omitted at the end of a line.
+	const char* keySeparator = " => "; ///< Printed between map key and content
+	const char* indent = "";		   ///< Printed at the start of each line when wrapping
+	uint16_t itemsPerLine = 0;		   ///< Start a new line after this many items, 0 for no wrapping
+	uint8_t radix = 10;				   ///< Number base for integers, 2 to 36
+	uint8_t width = 0;				   ///< Minimum width for numbers, padded on the left
+	uint8_t precision = 2;			   ///< Number of decimal places for floating-point values
+	char fill = ' ';				   ///< Padding character. With '0' any sign is placed before the padding.
+	char quote = '\0';				   ///< If set, String values are enclosed with this character
+
+	/**
+	 * @brief Get the default format for Map printers
+	 */
+	static PrintFormat forMap()
+	{
+		PrintFormat format;
+		format.separator = "";
+		format.indent = "  ";
+		format.itemsPerLine = 1;
+		return format;
+	}
+
+	/**
+	 * @brief Print the prefix
+	 */
+	size_t printStart(Print& p) const
+	{
+		return p.print(prefix);
+	}
+
+	/**
+	 * @brief Print any separator and line break required before an item
+	 * @param p
+	 * @param index Index of the item about to be printed
+	 */
+	size_t printSeparator(Print& p, unsigned index) const;
+
+	/**
+	 * @brief Print any final line break and the suffix
+	 */
+	size_t printEnd(Print& p) const;
+
+	/**
+	 * @brief Print an integer using radix and width
+	 * @param p
+	 * @param value Magnitude of the value
+	 * @param negative true to print a minus sign
+	 */
+	size_t printNumber(Print& p, uint32_t value, bool negative) const;
+
+	size_t printNumber(Print& p, uint64_t value, bool negative) const;
+
+	/**
+	 * @brief Print a floating-point value using precision and width
+	 */
+	size_t printNumber(Print& p, double value) const;
+
+	/**
+	 * @brief Print text padded to width
+	 */
+	size_t printPadded(Print& p, const char* text, size_t length) const;
+};
+
+/**
+ * @name Print an element
+ * @{
+ */
+
+template <typename T>
+typename std::enable_if<!std::is_same<T, char>::value, size_t>::type printElement(Print& p, const T& e)
+{
+	return print(p, e);
+}
+
+size_t printElement(Print& p, char c);
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value,
+						size_t>::type
+printElement(Print& p, T value, const PrintFormat& format)
+{
+	using U = typename std::make_unsigned<T>::type;
+	using N = typename std::conditional<(sizeof(T) <= 4), uint32_t, uint64_t>::type;
+	if(std::is_signed<T>::value && format.radix == 10 && value < T(0)) {
+		return format.printNumber(p, N(U(U(0) - U(value))), true);
+	}
+	return format.printNumber(p, N(U(value)), false);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, size_t>::type printElement(Print& p, T value,
+																					 const PrintFormat& format)
+{
+	return format.printNumber(p, double(value));
+}
+
+inline size_t printElement(Print& p, char c, const PrintFormat&)
+{
+	return printElement(p, c);
+}
+
+template <typename T>
+typename std::enable_if<std::is_base_of<String, T>::value, size_t>::type printElement(Print& p, const T& value,
+																					   const PrintFormat& format)
+{
+	if(format.quote == '\0') {
+		return print(p, value);
+	}
+	size_t count = p.print(format.quote);
+	count += print(p, value);
+	count += p.print(format.quote);
+	return count;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_base_of<String, T>::value, size_t>::type
+printElement(Print& p, const T& value, const PrintFormat&)
+{
+	return print(p, value);
+}
+
+inline size_t printElement(Print& p, bool value, const PrintFormat&)
+{
+	return print(p, value);
+}
+
+/** @} */
+
+} // namespace FSTR
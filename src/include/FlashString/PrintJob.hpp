@@ -0,0 +1,322 @@
+/****
+ * PrintJob.hpp - Resumable printing of large objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "String.hpp"
+#include "ArrayPrinter.hpp"
+#include <Delegate.h>
+
+/**
+ * @defgroup fstr_print_job Print jobs
+ * @ingroup fstr_print
+ * @{
+ */
+
+namespace FSTR
+{
+/**
+ * @brief Base class for resumable printing
+ *
+ * Printers such as ArrayPrinter write everything in one call, which blocks if the output is slow
+ * and loses progress if the output accepts only part of the data. A PrintJob keeps track of its
+ * position so it can write as much as the output accepts, then continue later.
+ *
+ * Output is divided into segments. Each is either short text rendered into RAM, such as separators and
+ * numeric values, or the content of a String object which is written directly from flash.
+ *
+ * Call `step()` repeatedly until `isFinished()` returns true, or use `submit()` to run the job
+ * using the task queue.
+ */
+class PrintJob
+{
+public:
+	using CompleteCallback = Delegate<void(PrintJob& job)>;
+
+	PrintJob(Print& output) : output(output)
+	{
+	}
+
+	PrintJob(const PrintJob&) = delete;
+	PrintJob& operator=(const PrintJob&) = delete;
+
+	virtual ~PrintJob()
+	{
+	}
+
+	/**
+	 * @brief Write as much output as possible
+	 * @param maxBytes Maximum number of bytes to write in this call
+	 * @retval size_t Number of bytes written, 0 if finished or output is full
+	 */
+	size_t step(size_t maxBytes = SIZE_MAX);
+
+	bool isFinished() const
+	{
+		return finished;
+	}
+
+	/**
+	 * @brief Determine if a job run using `submit()` was abandoned because the task queue was full
+	 */
+	bool hasError() const
+	{
+		return error;
+	}
+
+	/**
+	 * @brief Get total number of bytes written so far
+	 */
+	size_t getWriteCount() const
+	{
+		return writeCount;
+	}
+
+	/**
+	 * @brief Run job using the task queue
+	 * @param bytesPerTask Maximum number of bytes written by each task
+	 * @param callback Invoked when job has finished, or on error
+	 * @retval bool false if task queue is full
+	 * @note The job must remain valid until complete. If the output refuses data the job
+	 * is re-queued, so the output should be one which drains without further intervention.
+	 * If re-queueing fails the callback is invoked with `hasError()` true and `isFinished()` false.
+	 * The job may then be submitted again to continue from where it stopped.
+	 */
+	bool submit(size_t bytesPerTask = 1024, CompleteCallback callback = nullptr);
+
+protected:
+	/**
+	 * @brief Implemented by derived classes to set up the next output segment
+	 * @retval bool false when there is no more output
+	 *
+	 * Implementations either print to `text()` or call `setObject()`.
+	 */
+	virtual bool nextSegment() = 0;
+
+	/**
+	 * @brief Get a Print object for rendering the next text segment
+	 * @note Text is cleared on each call
+	 */
+	Print& text()
+	{
+		textBuffer.setLength(0);
+		object = nullptr;
+		return textPrint;
+	}
+
+	/**
+	 * @brief Set the next segment to be the content of an object
+	 */
+	void setObject(const ObjectBase& obj)
+	{
+		textBuffer.setLength(0);
+		object = &obj;
+	}
+
+	/**
+	 * @brief Set next segment from a value, streaming String content from flash
+	 */
+	template <typename T> typename std::enable_if<std::is_base_of<String, T>::value>::type setValue(const T& value)
+	{
+		setObject(value);
+	}
+
+	template <typename T> typename std::enable_if<!std::is_base_of<String, T>::value>::type setValue(const T& value)
+	{
+		printElement(text(), value);
+	}
+
+private:
+	class TextPrint : public Print
+	{
+	public:
+		TextPrint(WString& buffer) : buffer(buffer)
+		{
+		}
+
+		size_t write(uint8_t c) override
+		{
+			return write(&c, 1);
+		}
+
+		size_t write(const uint8_t* buffer, size_t size) override
+		{
+			return this->buffer.concat(reinterpret_cast<const char*>(buffer), size) ? size : 0;
+		}
+
+	private:
+		WString& buffer;
+	};
+
+	void runTask();
+
+	Print& output;
+	WString textBuffer;
+	TextPrint textPrint{textBuffer};
+	const ObjectBase* object{nullptr};
+	size_t segmentPos{0};
+	size_t writeCount{0};
+	size_t bytesPerTask{0};
+	CompleteCallback callback;
+	bool started{false};
+	bool finished{false};
+	bool error{false};
+};
+
+/**
+ * @brief Print the content of a String
+ */
+class StringPrintJob : public PrintJob
+{
+public:
+	StringPrintJob(Print& output, const String& string) : PrintJob(output), string(string)
+	{
+	}
+
+protected:
+	bool nextSegment() override
+	{
+		if(done) {
+			return false;
+		}
+		setObject(string);
+		done = true;
+		return true;
+	}
+
+private:
+	const String& string;
+	bool done{false};
+};
+
+/**
+ * @brief Print an Array or Vector in the same format as ArrayPrinter
+ */
+template <class ArrayType> class ArrayPrintJob : public PrintJob
+{
+public:
+	ArrayPrintJob(Print& output, const ArrayType& array) : PrintJob(output), array(array)
+	{
+	}
+
+protected:
+	bool nextSegment() override
+	{
+		auto len = array.length();
+		switch(state) {
+		case State::start:
+			text().print('{');
+			state = (len == 0) ? State::end : State::element;
+			return true;
+		case State::separator:
+			text().print(", ");
+			state = State::element;
+			return true;
+		case State::element:
+			setValue(array[index++]);
+			state = (index < len) ? State::separator : State::end;
+			return true;
+		case State::end:
+			text().print('}');
+			state = State::done;
+			return true;
+		case State::done:
+		default:
+			return false;
+		}
+	}
+
+private:
+	enum class State {
+		start,
+		separator,
+		element,
+		end,
+		done,
+	};
+
+	const ArrayType& array;
+	unsigned index{0};
+	State state{State::start};
+};
+
+/**
+ * @brief Print a Map in the same format as MapPrinter
+ */
+template <class MapType> class MapPrintJob : public PrintJob
+{
+public:
+	MapPrintJob(Print& output, const MapType& map) : PrintJob(output), map(map)
+	{
+	}
+
+protected:
+	bool nextSegment() override
+	{
+		switch(state) {
+		case State::start:
+			text().println("{");
+			state = (map.length() == 0) ? State::end : State::key;
+			return true;
+		case State::key: {
+			auto& p = text();
+			p.print("  ");
+			auto pair = map.valueAt(index);
+			print(p, pair.key());
+			p.print(_F(" => "));
+			state = State::content;
+			return true;
+		}
+		case State::content:
+			setValue(map.valueAt(index).content());
+			state = State::lineEnd;
+			return true;
+		case State::lineEnd:
+			text().println();
+			++index;
+			state = (index < map.length()) ? State::key : State::end;
+			return true;
+		case State::end:
+			text().print('}');
+			state = State::done;
+			return true;
+		case State::done:
+		default:
+			return false;
+		}
+	}
+
+private:
+	enum class State {
+		start,
+		key,
+		content,
+		lineEnd,
+		end,
+		done,
+	};
+
+	const MapType& map;
+	unsigned index{0};
+	State state{State::start};
+};
+
+} // namespace FSTR
+
+/** @} */
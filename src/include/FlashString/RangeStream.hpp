@@ -0,0 +1,171 @@
+/****
+ * RangeStream.hpp - Streams for serving part of an object
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "ObjectBase.hpp"
+#include <Data/Stream/DataSourceStream.h>
+#include <algorithm>
+#include <climits>
+#include <initializer_list>
+#include <memory>
+
+namespace FSTR
+{
+/**
+ * @brief Identifies a range of bytes within an object
+ */
+struct ByteRange {
+	uint32_t offset;
+	uint32_t length;
+};
+
+/**
+ * @brief Stream providing a range of bytes from an object
+ * @ingroup fstr_stream
+ *
+ * Positions and lengths are relative to the range, so `available()` and `isFinished()` behave
+ * as if the range were the entire object. Use this to respond to HTTP `Range` requests.
+ */
+class RangeStream : public IDataSourceStream
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param object
+	 * @param offset Start of range
+	 * @param length Number of bytes in range
+	 * @note Range is truncated if it extends beyond the end of the object
+	 */
+	RangeStream(const ObjectBase& object, size_t offset, size_t length);
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	int available() override
+	{
+		return int(length - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= length;
+	}
+
+	/**
+	 * @brief Get a pointer to data at the current read position, without copying
+	 * @see See `ObjectBase::getDirectBuffer()`
+	 */
+	const uint8_t* getDirectBuffer(size_t maxLen, size_t& count) const
+	{
+		return object.getDirectBuffer(offset + readPos, std::min(maxLen, length - readPos), count);
+	}
+
+	/**
+	 * @brief Get the range, truncated to the object size
+	 */
+	ByteRange getRange() const
+	{
+		return {offset, length};
+	}
+
+private:
+	const ObjectBase& object;
+	uint32_t offset;
+	uint32_t length;
+	size_t readPos{0};
+};
+
+/**
+ * @brief Stream providing several ranges from an object as a `multipart/byteranges` body
+ * @ingroup fstr_stream
+ *
+ * Each range is preceded by a part header containing `Content-Type` and `Content-Range`.
+ * The total length is calculated on construction so may be used for `Content-Length`.
+ * Empty ranges are skipped. If none remain the stream is invalid, and the request should
+ * be answered with `416 Range Not Satisfiable`.
+ * The response content type must be set to `multipart/byteranges; boundary=...`
+ * using the same boundary value.
+ */
+class MultipartRangeStream : public IDataSourceStream
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param object
+	 * @param ranges List of ranges, truncated to the object size
+	 * @param contentType MIME type of the object
+	 * @param boundary Boundary string, at most 70 characters
+	 * @note contentType and boundary are not copied so must remain valid for the lifetime of this stream
+	 */
+	MultipartRangeStream(const ObjectBase& object, std::initializer_list<ByteRange> ranges, const char* contentType,
+						 const char* boundary);
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	bool isValid() const override
+	{
+		return rangeCount != 0 && segmentStarts && headerBuffer;
+	}
+
+	int available() override
+	{
+		return int(totalLength - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= totalLength;
+	}
+
+private:
+	/*
+	 * Segments alternate between part headers and range data, ending with the closing delimiter.
+	 * Even segments are text, odd segments are data.
+	 */
+	size_t readSegment(unsigned segment, size_t offset, char* data, size_t count);
+	const char* getHeader(unsigned segment);
+
+	const ObjectBase& object;
+	const char* contentType;
+	const char* boundary;
+	std::unique_ptr<ByteRange[]> ranges;
+	unsigned rangeCount{0};
+	std::unique_ptr<uint32_t[]> segmentStarts; ///< Position of each segment, plus total length
+	std::unique_ptr<char[]> headerBuffer;
+	unsigned headerSegment{UINT_MAX}; ///< Segment whose text is in headerBuffer
+	size_t headerLength{0};
+	size_t totalLength{0};
+	size_t readPos{0};
+};
+
+} // namespace FSTR
@@ -0,0 +1,478 @@
+/****
+ * Serialize.hpp - Support for serializing objects directly from flash
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Array.hpp"
+#include "Vector.hpp"
+#include "Map.hpp"
+#include "MultiMap.hpp"
+#include "ColumnarMap.hpp"
+#include "InlineKeyMap.hpp"
+#include "Table.hpp"
+#include <limits>
+
+/**
+ * @defgroup fstr_serialize Serialization
+ * @ingroup FlashString
+ * @{
+ */
+
+#ifndef FSTR_SERIALIZE_MAX_DEPTH
+/**
+ * @brief Maximum nesting depth for serialized output
+ *
+ * Objects nested more deeply are output as null.
+ */
+#define FSTR_SERIALIZE_MAX_DEPTH 8
+#endif
+
+namespace FSTR
+{
+namespace Serialize
+{
+enum class Kind : uint8_t {
+	string,
+	array,
+	object,
+};
+
+/**
+ * @brief Identifies arrays of numeric values which may be output in bulk
+ */
+enum class ElementClass : uint8_t {
+	other,
+	unsignedInt,
+	signedInt,
+	floatingPoint,
+};
+
+struct TypeInfo;
+
+/**
+ * @brief A value to be serialized, either a scalar or a reference to an object
+ */
+struct Value {
+	enum class Type : uint8_t {
+		null,
+		boolean,
+		integer,
+		real,
+		object,
+	};
+
+	Type type;
+	bool negative;  ///< For integer, magnitude is stored
+	uint8_t digits; ///< For real, number of significant decimal digits in source type
+	union {
+		bool boolean;
+		uint64_t integer;
+		double real;
+		const void* object;
+	};
+	const TypeInfo* info; ///< Describes how to serialize object
+
+	void setNull()
+	{
+		type = Type::null;
+	}
+
+	void setBool(bool value)
+	{
+		type = Type::boolean;
+		boolean = value;
+	}
+
+	void setInteger(uint64_t magnitude, bool negative)
+	{
+		type = Type::integer;
+		integer = magnitude;
+		this->negative = negative;
+	}
+
+	void setReal(double value, uint8_t digits)
+	{
+		type = Type::real;
+		real = value;
+		this->digits = digits;
+	}
+
+	void setObject(const void* object, const TypeInfo& info)
+	{
+		type = Type::object;
+		this->object = object;
+		this->info = &info;
+	}
+};
+
+/**
+ * @brief Describes how to serialize an object type
+ *
+ * Items are always requested in order. `cursor` is initially nullptr and may be used to track
+ * position where indexed access is slow.
+ * For objects, `key` receives either a String or a scalar value.
+ *
+ * Strings, and Arrays with an element class other than `other`, are ObjectBase instances
+ * whose content may be read directly.
+ */
+struct TypeInfo {
+	Kind kind;
+	ElementClass elementClass;
+	uint8_t elementSize;
+	unsigned (*length)(const void* object);
+	void (*getItem)(const void* object, unsigned index, const void*& cursor, Value& key, Value& value);
+};
+
+/**
+ * @name Set a Value for each supported element type
+ * @{
+ */
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type setValue(Value& v,
+																									  T value)
+{
+	using U = typename std::make_unsigned<T>::type;
+	bool negative = std::is_signed<T>::value && value < T(0);
+	v.setInteger(negative ? U(U(0) - U(value)) : U(value), negative);
+}
+
+template <typename T> typename std::enable_if<std::is_enum<T>::value>::type setValue(Value& v, T value)
+{
+	setValue(v, typename std::underlying_type<T>::type(value));
+}
+
+template <typename T> typename std::enable_if<std::is_floating_point<T>::value>::type setValue(Value& v, T value)
+{
+	v.setReal(value, std::numeric_limits<T>::digits10);
+}
+
+inline void setValue(Value& v, bool value)
+{
+	v.setBool(value);
+}
+
+template <class T>
+typename std::enable_if<std::is_base_of<ObjectBase, T>::value>::type setValue(Value& v, const T& object);
+
+/**
+ * @brief Set value for an element stored in flash
+ */
+template <typename T>
+typename std::enable_if<!std::is_class<T>::value && !std::is_pointer<T>::value>::type setElement(Value& v,
+																								   const T* ptr)
+{
+	setValue(v, readValue(ptr));
+}
+
+/**
+ * @brief Set value for an object referenced from flash, as for a Vector
+ */
+template <class T> void setElement(Value& v, const T* const* ptr)
+{
+	auto object = readValue(ptr);
+	if(object == nullptr) {
+		v.setNull();
+	} else {
+		setValue(v, *object);
+	}
+}
+
+template <typename ElementType, size_t Columns> void setElement(Value& v, const TableRow<ElementType, Columns>* row);
+
+/** @} */
+
+/**
+ * @name Type information for supported object types
+ * @{
+ */
+
+template <typename T> constexpr ElementClass getElementClass()
+{
+	return std::is_floating_point<T>::value ? ElementClass::floatingPoint
+		   : (!std::is_integral<T>::value || std::is_same<T, bool>::value) ? ElementClass::other
+		   : std::is_signed<T>::value ? ElementClass::signedInt
+									  : ElementClass::unsignedInt;
+}
+
+template <class ArrayType, ElementClass elementClass = ElementClass::other, uint8_t elementSize = 0>
+struct ArrayTypeInfo {
+	static unsigned length(const void* object)
+	{
+		return static_cast<const ArrayType*>(object)->length();
+	}
+
+	static void getItem(const void* object, unsigned index, const void*&, Value&, Value& value)
+	{
+		setElement(value, static_cast<const ArrayType*>(object)->data() + index);
+	}
+
+	static constexpr TypeInfo info{Kind::array, elementClass, elementSize, length, getItem};
+};
+
+template <class RowType> struct TableRowTypeInfo {
+	static unsigned length(const void*)
+	{
+		return RowType::empty().length();
+	}
+
+	static void getItem(const void* object, unsigned index, const void*&, Value&, Value& value)
+	{
+		setElement(value, &static_cast<const RowType*>(object)->values[index]);
+	}
+
+	static constexpr TypeInfo info{Kind::array, ElementClass::other, 0, length, getItem};
+};
+
+template <class MapType> struct MapTypeInfo {
+	static unsigned length(const void* object)
+	{
+		return static_cast<const MapType*>(object)->length();
+	}
+
+	static void getItem(const void* object, unsigned index, const void*&, Value& key, Value& value)
+	{
+		setPair(key, value, static_cast<const MapType*>(object)->valueAt(index));
+	}
+
+	template <class Pair> static void setPair(Value& key, Value& value, const Pair& pair)
+	{
+		setValue(key, pair.key());
+		if(pair) {
+			setValue(value, pair.content());
+		} else {
+			value.setNull();
+		}
+	}
+
+	static constexpr TypeInfo info{Kind::object, ElementClass::other, 0, length, getItem};
+};
+
+/**
+ * @brief InlineKeyMap keys are located by stepping through them, so track the current key
+ */
+template <class MapType> struct InlineKeyMapTypeInfo : public MapTypeInfo<MapType> {
+	static void getItem(const void* object, unsigned index, const void*& cursor, Value& key, Value& value)
+	{
+		auto& map = *static_cast<const MapType*>(object);
+		auto k = cursor ? MapType::nextKey(static_cast<const String*>(cursor)) : map.firstKey();
+		cursor = k;
+		MapTypeInfo<MapType>::setPair(key, value, typename MapType::Pair{k, readValue(map.data() + index)});
+	}
+
+	static constexpr TypeInfo info{Kind::object, ElementClass::other, 0, MapTypeInfo<MapType>::length, getItem};
+};
+
+extern const TypeInfo stringTypeInfo;
+
+inline const TypeInfo& typeInfo(const String&)
+{
+	return stringTypeInfo;
+}
+
+/**
+ * @brief Arrays of char are output as strings
+ */
+inline const TypeInfo& typeInfo(const Array<char>&)
+{
+	return stringTypeInfo;
+}
+
+template <typename ElementType> const TypeInfo& typeInfo(const Array<ElementType>&)
+{
+	return ArrayTypeInfo<Array<ElementType>, getElementClass<ElementType>(), sizeof(ElementType)>::info;
+}
+
+template <class ObjectType> const TypeInfo& typeInfo(const Vector<ObjectType>&)
+{
+	return ArrayTypeInfo<Vector<ObjectType>>::info;
+}
+
+template <typename KeyType, class ContentType> const TypeInfo& typeInfo(const Map<KeyType, ContentType>&)
+{
+	return MapTypeInfo<Map<KeyType, ContentType>>::info;
+}
+
+template <typename KeyType, class ContentType> const TypeInfo& typeInfo(const MultiMap<KeyType, ContentType>&)
+{
+	return MapTypeInfo<MultiMap<KeyType, ContentType>>::info;
+}
+
+template <typename KeyType, class ContentType> const TypeInfo& typeInfo(const ColumnarMap<KeyType, ContentType>&)
+{
+	return MapTypeInfo<ColumnarMap<KeyType, ContentType>>::info;
+}
+
+template <class ContentType> const TypeInfo& typeInfo(const InlineKeyMap<ContentType>&)
+{
+	return InlineKeyMapTypeInfo<InlineKeyMap<ContentType>>::info;
+}
+
+/** @} */
+
+template <class T>
+typename std::enable_if<std::is_base_of<ObjectBase, T>::value>::type setValue(Value& v, const T& object)
+{
+	v.setObject(&object, typeInfo(object));
+}
+
+template <typename ElementType, size_t Columns> void setElement(Value& v, const TableRow<ElementType, Columns>* row)
+{
+	v.setObject(row, TableRowTypeInfo<TableRow<ElementType, Columns>>::info);
+}
+
+/**
+ * @brief Base class for generating serialized output on demand
+ *
+ * Output is produced in small pieces using a fixed-size stack, so RAM usage does not depend
+ * on the size of the object.
+ *
+ * Supported objects are String, Array, Vector, Map, MultiMap, ColumnarMap, InlineKeyMap
+ * and Arrays of TableRow, nested in any combination. Map keys must be String, integral, enum or floating-point.
+ * Arrays of char are output as strings. Null object references are output as null.
+ */
+class Generator
+{
+public:
+	virtual ~Generator()
+	{
+	}
+
+	/**
+	 * @brief Start again from the beginning
+	 */
+	void restart();
+
+	/**
+	 * @brief Read output
+	 * @param buffer
+	 * @param size
+	 * @retval size_t Number of bytes read, less than size only if output is complete
+	 */
+	size_t read(void* buffer, size_t size);
+
+	/**
+	 * @brief Skip output
+	 * @param count Number of bytes to skip
+	 * @retval size_t Number of bytes skipped, less than count only if output is complete
+	 */
+	size_t skip(size_t count);
+
+	/**
+	 * @brief Write remaining output
+	 * @retval size_t Number of bytes written
+	 */
+	size_t printTo(Print& p);
+
+	/**
+	 * @brief Get total length of the output by generating it
+	 * @note Generator is restarted
+	 */
+	size_t measure();
+
+	bool isFinished() const
+	{
+		return depth == 0 && textPos == textLength;
+	}
+
+protected:
+	template <class ObjectType> Generator(const ObjectType& object) : root(&object), rootType(&typeInfo(object))
+	{
+		restart();
+	}
+
+	enum class State : uint8_t {
+		start,
+		next,
+		value,
+	};
+
+	struct Frame {
+		const void* object;
+		const TypeInfo* type;
+		const void* cursor;
+		unsigned length;
+		unsigned index; ///< Item index, or offset into content
+		State state;
+	};
+
+	/**
+	 * @brief Produce the next piece of output
+	 *
+	 * Called only when the text buffer is empty.
+	 */
+	virtual void step() = 0;
+
+	Frame& top()
+	{
+		return stack[depth - 1];
+	}
+
+	void pop()
+	{
+		--depth;
+	}
+
+	/**
+	 * @brief Start output of an object
+	 * @retval bool false if nesting is too deep
+	 */
+	bool push(const Value& value);
+
+	/**
+	 * @brief Copy object content into the text buffer, as much as will fit
+	 * @param frame Frame for a String or Array, `index` is updated
+	 * @param size Total size of the content in bytes
+	 */
+	void emitContent(Frame& frame, size_t size);
+
+	void emit(uint8_t c)
+	{
+		text[textLength++] = c;
+	}
+
+	void emit(const void* data, size_t len)
+	{
+		memcpy(&text[textLength], data, len);
+		textLength += len;
+	}
+
+	size_t space() const
+	{
+		return sizeof(text) - textLength;
+	}
+
+	Value pending; ///< Map content, waiting for key output to complete
+	uint8_t text[64];
+
+private:
+	size_t fill();
+
+	const void* root;
+	const TypeInfo* rootType;
+	Frame stack[FSTR_SERIALIZE_MAX_DEPTH];
+	uint8_t depth{0};
+	uint8_t textPos{0};
+	uint8_t textLength{0};
+};
+
+} // namespace Serialize
+} // namespace FSTR
+
+/** @} */
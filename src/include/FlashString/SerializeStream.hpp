@@ -0,0 +1,108 @@
+/****
+ * SerializeStream.hpp - Stream providing serialized output
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Serialize.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+namespace Serialize
+{
+/**
+ * @brief Stream providing output from a Generator
+ * @ingroup fstr_serialize
+ * @tparam GeneratorType Class derived from Generator
+ *
+ * Output is generated on demand so RAM usage is small and does not depend on the size of the object.
+ * The total length is calculated on construction so may be used for `Content-Length`.
+ *
+ * Seeking backwards requires output to be generated again from the beginning.
+ */
+template <class GeneratorType> class GeneratorStream : public IDataSourceStream
+{
+public:
+	template <typename... Args> GeneratorStream(const Args&... args) : generator(args...)
+	{
+		length = generator.measure();
+	}
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	int available() override
+	{
+		return int(length - readPos);
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override
+	{
+		if(bufSize <= 0) {
+			return 0;
+		}
+		// Read from a copy as this must not change stream position
+		GeneratorType gen(generator);
+		return gen.read(data, std::min(size_t(bufSize), size_t(UINT16_MAX)));
+	}
+
+	int seekFrom(int offset, SeekOrigin origin) override
+	{
+		size_t newPos;
+		switch(origin) {
+		case SeekOrigin::Start:
+			newPos = offset;
+			break;
+		case SeekOrigin::Current:
+			newPos = readPos + offset;
+			break;
+		case SeekOrigin::End:
+			newPos = length + offset;
+			break;
+		default:
+			return -1;
+		}
+
+		if(newPos > length) {
+			return -1;
+		}
+
+		if(newPos < readPos) {
+			generator.restart();
+			readPos = 0;
+		}
+		readPos += generator.skip(newPos - readPos);
+		return readPos;
+	}
+
+	bool isFinished() override
+	{
+		return readPos >= length;
+	}
+
+private:
+	GeneratorType generator;
+	size_t length;
+	size_t readPos{0};
+};
+
+} // namespace Serialize
+} // namespace FSTR
@@ -66,6 +66,30 @@ public:
 		return readPos >= object.length();
 	}
 
+	/**
+	 * @brief Get a pointer to data at the current read position, without copying
+	 * @param maxLen Maximum number of bytes required
+	 * @param length On success, number of bytes available
+	 * @retval const uint8_t* nullptr if direct access is not supported
+	 * @see See `ObjectBase::getDirectBuffer()`
+	 * @note Stream position is not changed, call `seek()` to consume data
+	 */
+	const uint8_t* getDirectBuffer(size_t maxLen, size_t& length) const
+	{
+		return object.getDirectBuffer(readPos, maxLen, length);
+	}
+
+	/**
+	 * @brief Write stream content to a Print object
+	 * @param p
+	 * @param maxLen Maximum number of bytes to write
+	 * @retval size_t Number of bytes written
+	 *
+	 * Data is written directly from flash if supported, otherwise copied via a stack buffer.
+	 * The stream position is advanced by the number of bytes written.
+	 */
+	size_t writeTo(Print& p, size_t maxLen = SIZE_MAX);
+
 private:
 	const ObjectBase& object;
 	size_t readPos = 0;
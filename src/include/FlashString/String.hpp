@@ -137,6 +137,17 @@ typedef const __FlashStringHelper* flash_string_t;
  */
 #define IMPORT_FSTR_LOCAL(name, file) IMPORT_FSTR_OBJECT_LOCAL(name, FSTR::String, file)
 
+/**
+ * @brief Define a FSTR::String containing data from an external file, with digest
+ * @see See also `IMPORT_FSTR_OBJECT_DIGEST`
+ */
+#define IMPORT_FSTR_DIGEST(name, file) IMPORT_FSTR_OBJECT_DIGEST(name, FSTR::String, file)
+
+/**
+ * @brief Like IMPORT_FSTR_DIGEST except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_DIGEST_LOCAL(name, file) IMPORT_FSTR_OBJECT_DIGEST_LOCAL(name, FSTR::String, file)
+
 /**
  * @brief declare a table of FlashStrings
  * @param name name of the table
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "Object.hpp"
 #include "ArrayPrinter.hpp"
 
 /**
@@ -29,6 +30,82 @@
  * @{
  */
 
+/**
+ * @brief Declare a global Table& reference
+ * @param name
+ * @param ElementType
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @note Use `DEFINE_FSTR_TABLE` to instantiate the global Object
+ */
+#define DECLARE_FSTR_TABLE(name, ElementType, rows, columns)                                                           \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::Table<ElementType, rows, columns>)))
+
+/**
+ * @brief Define a Table Object with global reference, stored in row-major order
+ * @param name Name of Table& reference to define
+ * @param ElementType
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param ... List of ElementType items, one row after another
+ */
+#define DEFINE_FSTR_TABLE(name, ElementType, rows, columns, ...)                                                       \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, rows, columns, FSTR::TableLayout::rowMajor,      \
+								  __VA_ARGS__);                                                                        \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_TABLE except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_TABLE_LOCAL(name, ElementType, rows, columns, ...)                                                 \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, rows, columns, FSTR::TableLayout::rowMajor,      \
+								  __VA_ARGS__);                                                                        \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Declare a global Table& reference for a table stored in column-major order
+ * @note Use `DEFINE_FSTR_COLUMNAR_TABLE` to instantiate the global Object
+ */
+#define DECLARE_FSTR_COLUMNAR_TABLE(name, ElementType, rows, columns)                                                  \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::Table<ElementType, rows, columns, FSTR::TableLayout::columnMajor>)))
+
+/**
+ * @brief Define a Table Object with global reference, stored in column-major order
+ * @param name Name of Table& reference to define
+ * @param ElementType
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param ... List of ElementType items, one column after another
+ */
+#define DEFINE_FSTR_COLUMNAR_TABLE(name, ElementType, rows, columns, ...)                                              \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, rows, columns, FSTR::TableLayout::columnMajor,   \
+								  __VA_ARGS__);                                                                        \
+	DEFINE_FSTR_REF(name)
+
+/**
+ * @brief Like DEFINE_FSTR_COLUMNAR_TABLE except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_COLUMNAR_TABLE_LOCAL(name, ElementType, rows, columns, ...)                                        \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, rows, columns, FSTR::TableLayout::columnMajor,   \
+								  __VA_ARGS__);                                                                        \
+	DEFINE_FSTR_REF_LOCAL(name)
+
+/**
+ * @brief Define a Table data structure
+ * @param name Name of data structure
+ * @param ElementType
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param layout TableLayout value
+ * @param ... List of ElementType items in storage order
+ */
+#define DEFINE_FSTR_TABLE_DATA(name, ElementType, rows, columns, layout, ...)                                          \
+	constexpr const struct {                                                                                           \
+		FSTR::Table<ElementType, rows, columns, layout> object;                                                        \
+		ElementType data[(rows) * (columns)];                                                                          \
+	} FSTR_PACKED name PROGMEM = {{sizeof(ElementType) * (rows) * (columns)}, {__VA_ARGS__}};                          \
+	FSTR_CHECK_STRUCT(name);
+
 namespace FSTR
 {
 /**
@@ -61,12 +138,20 @@ public:
 		return Columns;
 	}
 
+	/**
+	 * @brief Returns a printer object for this row
+	 */
+	ArrayPrinter<TableRow> printer(const PrintFormat& format = {}) const
+	{
+		return ArrayPrinter<TableRow>(*this, format);
+	}
+
 	/**
 	 * @brief Print a row using Array Printer
 	 */
 	size_t printTo(Print& p) const
 	{
-		return FSTR::ArrayPrinter<TableRow>(*this).printTo(p);
+		return printer().printTo(p);
 	}
 
 	/**
@@ -82,6 +167,256 @@ public:
 	ElementType values[Columns];
 };
 
+/**
+ * @brief Order in which Table elements are stored
+ */
+enum class TableLayout {
+	rowMajor,	///< Each row is stored contiguously
+	columnMajor, ///< Each column is stored contiguously
+};
+
+/**
+ * @brief View of a single row or column of a Table
+ * @tparam ElementType
+ *
+ * Elements are located at a fixed interval (the stride) in flash.
+ * When the stride is 1 the elements are contiguous and may be read in a single operation.
+ */
+template <typename ElementType> class TableSlice
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const TableSlice& slice, unsigned index) : slice(slice), index(index)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return &slice == &rhs.slice && index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		ElementType operator*() const
+		{
+			return slice[index];
+		}
+
+	private:
+		const TableSlice& slice;
+		unsigned index;
+	};
+
+	TableSlice(const ElementType* data, size_t length, size_t stride) : dataptr(data), len(length), stride(stride)
+	{
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, len);
+	}
+
+	/**
+	 * @brief Get number of elements
+	 */
+	size_t length() const
+	{
+		return len;
+	}
+
+	/**
+	 * @brief Get the distance between elements in flash, 1 for contiguous elements
+	 */
+	size_t getStride() const
+	{
+		return stride;
+	}
+
+	/**
+	 * @brief Get an element
+	 * @retval ElementType Value-initialised if index is out of range
+	 */
+	ElementType operator[](unsigned index) const
+	{
+		return (index < len) ? readValue(dataptr + index * stride) : ElementType{};
+	}
+
+	/**
+	 * @brief Read elements into RAM
+	 * @param index First element to read
+	 * @param buffer Where to store data
+	 * @param count How many elements to read
+	 * @retval size_t Number of elements actually read
+	 */
+	size_t read(size_t index, ElementType* buffer, size_t count) const
+	{
+		if(index >= len) {
+			return 0;
+		}
+		count = std::min(count, len - index);
+		if(stride == 1) {
+			memcpy_P(buffer, dataptr + index, count * sizeof(ElementType));
+		} else {
+			auto ptr = dataptr + index * stride;
+			for(unsigned i = 0; i < count; ++i, ptr += stride) {
+				buffer[i] = readValue(ptr);
+			}
+		}
+		return count;
+	}
+
+	ArrayPrinter<TableSlice> printer(const PrintFormat& format = {}) const
+	{
+		return ArrayPrinter<TableSlice>(*this, format);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		return printer().printTo(p);
+	}
+
+private:
+	const ElementType* dataptr;
+	size_t len;
+	size_t stride;
+};
+
+/**
+ * @brief Class template to access a two-dimensional table stored in flash
+ * @tparam ElementType
+ * @tparam Rows Number of rows
+ * @tparam Columns Number of columns
+ * @tparam Layout Whether rows or columns are stored contiguously
+ *
+ * Individual elements are read using `at()`, without reading the rest of the row.
+ * Choose the layout according to how the table is most often scanned:
+ * `readRow()` or `readColumn()` are a single read when the slice is contiguous.
+ *
+ * The Object interface, such as iteration and `length()`, operates on all elements in storage order.
+ */
+template <typename ElementType, size_t Rows, size_t Columns, TableLayout Layout = TableLayout::rowMajor>
+class Table : public Object<Table<ElementType, Rows, Columns, Layout>, ElementType>
+{
+public:
+	static_assert(!std::is_pointer<ElementType>::value, "Pointer types not supported by Table - use Vector");
+
+	using Slice = TableSlice<ElementType>;
+
+	static constexpr size_t rows()
+	{
+		return Rows;
+	}
+
+	static constexpr size_t columns()
+	{
+		return Columns;
+	}
+
+	static constexpr TableLayout layout()
+	{
+		return Layout;
+	}
+
+	/**
+	 * @brief Get offset of an element from the start of the data, in elements
+	 */
+	static constexpr size_t elementOffset(size_t row, size_t column)
+	{
+		return (Layout == TableLayout::rowMajor) ? row * Columns + column : column * Rows + row;
+	}
+
+	/**
+	 * @brief Get a single element
+	 * @retval ElementType Value-initialised if row or column is out of range
+	 */
+	ElementType at(size_t row, size_t column) const
+	{
+		if(row >= Rows || column >= Columns || this->isNull()) {
+			return ElementType{};
+		}
+		return readValue(this->data() + elementOffset(row, column));
+	}
+
+	/**
+	 * @brief Get a view of a row
+	 * @retval Slice Empty if row is out of range
+	 */
+	Slice row(size_t row) const
+	{
+		if(row >= Rows || this->isNull()) {
+			return Slice(nullptr, 0, 1);
+		}
+		return Slice(this->data() + elementOffset(row, 0), Columns, elementOffset(0, 1));
+	}
+
+	/**
+	 * @brief Get a view of a column
+	 * @retval Slice Empty if column is out of range
+	 */
+	Slice column(size_t column) const
+	{
+		if(column >= Columns || this->isNull()) {
+			return Slice(nullptr, 0, 1);
+		}
+		return Slice(this->data() + elementOffset(0, column), Rows, elementOffset(1, 0));
+	}
+
+	/**
+	 * @brief Read a complete row into RAM
+	 * @param row
+	 * @param buffer Must have space for `columns()` elements
+	 * @retval size_t Number of elements read, 0 if row is out of range
+	 */
+	size_t readRow(size_t row, ElementType* buffer) const
+	{
+		return this->row(row).read(0, buffer, Columns);
+	}
+
+	/**
+	 * @brief Read a complete column into RAM
+	 * @param column
+	 * @param buffer Must have space for `rows()` elements
+	 * @retval size_t Number of elements read, 0 if column is out of range
+	 */
+	size_t readColumn(size_t column, ElementType* buffer) const
+	{
+		return this->column(column).read(0, buffer, Rows);
+	}
+
+	/**
+	 * @brief Print table as a list of rows
+	 */
+	size_t printTo(Print& output) const
+	{
+		BufferedPrint<> p(output);
+		PrintFormat format;
+		format.printStart(p);
+		for(unsigned i = 0; i < Rows; ++i) {
+			format.printSeparator(p, i);
+			row(i).printTo(p);
+		}
+		format.printEnd(p);
+		p.flush();
+		return p.getOutputLength();
+	}
+} FSTR_PACKED;
+
 } // namespace FSTR
 
 /** @} */
@@ -83,47 +83,76 @@ template <typename T, typename U> struct argument_type<T(U)> {
  *
  * If the symbol is not referenced the content will be discarded by the linker.
  */
+
+/**
+ * @def IMPORT_FSTR_DATA_DIGEST
+ * @brief Link the contents of a file together with its pre-computed digest
+ *
+ * The digest is read from a sidecar file with `.digest` appended to the name, generated using
+ * `tools/fstrdigest.py`. It is appended to the object data and flagged in the length field.
+ *
+ * @see See `FSTR::ObjectBase::digest()`
+ */
 // clang-format off
 #define STR(x) XSTR(x)
 #define XSTR(x) #x
 #ifdef __WIN32
-#define IMPORT_FSTR_DATA(name, file)                                                                                   \
+#define IMPORT_FSTR_DATA_EX(name, file, flags, trailer)                                                                \
 	__asm__(".section .rodata\n"                                                                                       \
 			".def _" STR(name) "; .scl 2; .type 32; .endef\n"                                                          \
 			".align 4\n"                                                                                               \
 			"_" STR(name) ":\n"                                                                                        \
-			".long _" STR(name) "_end - _" STR(name) " - 4\n"                                                          \
+			".long _" STR(name) "_end - _" STR(name) " - 4 + " flags "\n"                                             \
 			".incbin \"" file "\"\n"                                                                                   \
-			"_" STR(name) "_end:\n");
+			"_" STR(name) "_end:\n"                                                                                    \
+			trailer);
 #elif defined(__APPLE__)
-#define IMPORT_FSTR_DATA(name, file)                                                                                   \
+#define IMPORT_FSTR_DATA_EX(name, file, flags, trailer)                                                                \
 	__asm__(".const_data\n"                                                                                            \
 			".globl _" STR(name) "\n"                                                                                  \
 			".align 4\n" "_" STR(name) ":\n"                                                                           \
-			".long _" STR(name) "_end - _" STR(name) " - 4\n"                                                          \
+			".long _" STR(name) "_end - _" STR(name) " - 4 + " flags "\n"                                             \
 			".incbin \"" file "\"\n"                                                                                   \
-			"_" STR(name) "_end:\n");
+			"_" STR(name) "_end:\n"                                                                                    \
+			trailer);
 #elif defined(__arm__)
-#define IMPORT_FSTR_DATA(name, file)                                                                                   \
+#define IMPORT_FSTR_DATA_EX(name, file, flags, trailer)                                                                \
 	__asm__(".section " ICACHE_RODATA_SECTION "." STR(name) "\n"                                                       \
 			".type " STR(name) ", %object\n"                                                                           \
 			".align 4\n" STR(name) ":\n"                                                                               \
-			".long _" STR(name) "_end - " STR(name) " - 4\n"                                                           \
+			".long _" STR(name) "_end - " STR(name) " - 4 + " flags "\n"                                              \
 			".incbin \"" file "\"\n"                                                                                   \
-			"_" STR(name) "_end:\n");
+			"_" STR(name) "_end:\n"                                                                                    \
+			trailer);
 #else
-#define IMPORT_FSTR_DATA(name, file)                                                                                   \
+#define IMPORT_FSTR_DATA_EX(name, file, flags, trailer)                                                                \
 	__asm__(".section " ICACHE_RODATA_SECTION "." STR(name) "\n"                                                       \
 			".type " STR(name) ", @object\n"                                                                           \
 			".align 4\n" STR(name) ":\n"                                                                               \
-			".long _" STR(name) "_end - " STR(name) " - 4\n"                                                           \
+			".long _" STR(name) "_end - " STR(name) " - 4 + " flags "\n"                                              \
 			".incbin \"" file "\"\n"                                                                                   \
-			"_" STR(name) "_end:\n");
+			"_" STR(name) "_end:\n"                                                                                    \
+			trailer);
 #endif
+#define IMPORT_FSTR_DATA(name, file) IMPORT_FSTR_DATA_EX(name, file, "0", "")
+#define IMPORT_FSTR_DATA_DIGEST(name, file)                                                                            \
+	IMPORT_FSTR_DATA_EX(name, file, STR(FSTR_LENGTH_DIGEST), ".balign 4\n.incbin \"" file ".digest\"\n")
 // clang-format on
 
 namespace FSTR
 {
+/**
+ * @brief Copy a block of flash memory with any alignment, using only aligned word reads
+ * @param dst Buffer in RAM
+ * @param src Location in flash
+ * @param size Number of bytes to copy
+ *
+ * Bytes are extracted from each word by shifting, so every word containing the requested data is
+ * read once. Used by readValue() for types whose size is not a multiple of 4, such as packed structures,
+ * since these may be located at any offset.
+ */
+void readUnaligned(void* dst, const void* src, size_t size);
+
 /**
  * @brief Read a typed value from flash memory ensuring correct alignment of access
  * @param ptr Typed pointer to flash data to be read
@@ -131,16 +160,29 @@ namespace FSTR
  * @{
  */
 
-template <typename T> FSTR_INLINE typename std::enable_if<sizeof(T) == 1, T>::type readValue(const T* ptr)
+template <typename T>
+FSTR_INLINE typename std::enable_if<sizeof(T) == 1 && !std::is_class<T>::value, T>::type readValue(const T* ptr)
 {
 	return static_cast<T>(pgm_read_byte(ptr));
 }
 
-template <typename T> FSTR_INLINE typename std::enable_if<sizeof(T) == 2, T>::type readValue(const T* ptr)
+template <typename T>
+FSTR_INLINE typename std::enable_if<sizeof(T) == 2 && !std::is_class<T>::value, T>::type readValue(const T* ptr)
 {
 	return static_cast<T>(pgm_read_word(ptr));
 }
 
+template <typename T>
+FSTR_INLINE typename std::enable_if<sizeof(T) <= 2 && std::is_class<T>::value, T>::type readValue(const T* ptr)
+{
+	union {
+		uint16_t u16;
+		T value;
+	} tmp;
+	tmp.u16 = (sizeof(T) == 1) ? pgm_read_byte(ptr) : pgm_read_word(ptr);
+	return tmp.value;
+}
+
 template <typename T> FSTR_INLINE typename std::enable_if<sizeof(T) == 4, T>::type readValue(const T* ptr)
 {
 	union {
@@ -159,6 +201,14 @@ FSTR_INLINE typename std::enable_if<(sizeof(T) > 4) && IS_ALIGNED(sizeof(T)), T>
 	return value;
 }
 
+template <typename T>
+typename std::enable_if<sizeof(T) == 3 || ((sizeof(T) > 4) && !IS_ALIGNED(sizeof(T))), T>::type readValue(const T* ptr)
+{
+	T value;
+	readUnaligned(&value, ptr, sizeof(T));
+	return value;
+}
+
 /** @} */
 
 } // namespace FSTR
@@ -160,9 +160,9 @@ public:
 
 	/* Arduino Print support */
 
-	ArrayPrinter<Vector> printer() const
+	ArrayPrinter<Vector> printer(const PrintFormat& format = {}) const
 	{
-		return ArrayPrinter<Vector>(*this);
+		return ArrayPrinter<Vector>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
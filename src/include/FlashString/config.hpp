@@ -39,9 +39,32 @@
 
 #define FSTR_VA_NARGS(type_, ...) (sizeof((const type_[]){__VA_ARGS__}) / sizeof(type_))
 
+/**
+ * @brief Remove parentheses from a list argument, e.g. `FSTR_UNPAREN (a, b, c)` becomes `a, b, c`
+ */
+#define FSTR_UNPAREN(...) __VA_ARGS__
+
 #ifndef ALIGNUP4
 /**
  * @brief Align a size up to the nearest word boundary
  */
 #define ALIGNUP4(n) (((n) + 3) & ~3)
 #endif
+
+/**
+ * @brief Flag set in an object length field to indicate a digest follows the data
+ * @note Must be a plain literal so it can be used in assembler
+ */
+#define FSTR_LENGTH_DIGEST 0x40000000
+
+#ifndef FSTR_DIRECT_ACCESS
+/**
+ * @brief Set if flash data may be accessed directly using byte pointers
+ * @note Flash on the esp8266 is memory-mapped but only supports aligned 32-bit reads
+ */
+#ifdef ARCH_ESP8266
+#define FSTR_DIRECT_ACCESS 0
+#else
+#define FSTR_DIRECT_ACCESS 1
+#endif
+#endif
@@ -21,6 +21,7 @@
 
 #include <SmingTest.h>
 #include "data.h"
+#include "capture.h"
 
 namespace
 {
@@ -78,6 +79,9 @@ struct InClassTest {
 	DEFINE_FSTR_ARRAY_LOCAL(localData, int, 10, 20, 30, 40, 50)
 };
 
+DEFINE_FSTR_ARRAY_LOCAL(formatArray, int, 0, 10, -5, 255)
+DEFINE_FSTR_ARRAY_LOCAL(formatDoubleArray, double, 1.5, -2.25)
+
 } // namespace
 
 class ArrayTest : public TestGroup
@@ -161,6 +165,208 @@ public:
 			Serial.println(" }");
 		}
 
+		TEST_CASE("Table")
+		{
+			FSTR::println(Serial, intTable);
+			REQUIRE(printToString(intTable) == "{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}");
+			REQUIRE(printToString(columnarIntTable) == printToString(intTable));
+
+			auto checkTable = [](const auto& table) {
+				REQUIRE_EQ(table.rows(), 3);
+				REQUIRE_EQ(table.columns(), 4);
+				REQUIRE_EQ(table.length(), 12);
+				for(unsigned row = 0; row < 3; ++row) {
+					for(unsigned col = 0; col < 4; ++col) {
+						REQUIRE_EQ(table.at(row, col), int16_t(1 + row * 4 + col));
+					}
+				}
+				REQUIRE_EQ(table.at(3, 0), 0);
+				REQUIRE_EQ(table.at(0, 4), 0);
+
+				auto column = table.column(2);
+				REQUIRE_EQ(column.length(), 3);
+				REQUIRE_EQ(column[1], 7);
+				REQUIRE_EQ(column[3], 0);
+				int sum = 0;
+				for(auto v : column) {
+					sum += v;
+				}
+				REQUIRE_EQ(sum, 3 + 7 + 11);
+				REQUIRE(printToString(column) == "{3, 7, 11}");
+				REQUIRE_EQ(table.column(4).length(), 0);
+
+				int16_t buffer[4]{};
+				REQUIRE_EQ(table.readRow(1, buffer), 4);
+				REQUIRE(buffer[0] == 5 && buffer[1] == 6 && buffer[2] == 7 && buffer[3] == 8);
+				REQUIRE_EQ(table.readRow(3, buffer), 0);
+				REQUIRE_EQ(table.readColumn(3, buffer), 3);
+				REQUIRE(buffer[0] == 4 && buffer[1] == 8 && buffer[2] == 12);
+				REQUIRE_EQ(table.row(2).read(1, buffer, 10), 3);
+				REQUIRE(buffer[0] == 10 && buffer[1] == 11 && buffer[2] == 12);
+			};
+
+			checkTable(intTable);
+			checkTable(columnarIntTable);
+
+			// Contiguous slices are read in one operation
+			REQUIRE_EQ(intTable.row(0).getStride(), 1);
+			REQUIRE_EQ(intTable.column(0).getStride(), 4);
+			REQUIRE_EQ(columnarIntTable.row(0).getStride(), 3);
+			REQUIRE_EQ(columnarIntTable.column(0).getStride(), 1);
+		}
+
+		TEST_CASE("Jagged array")
+		{
+			FSTR::println(Serial, jaggedArray);
+			REQUIRE(printToString(jaggedArray) == printToString(arrayVector));
+			REQUIRE_EQ(jaggedArray.rows(), arrayVector.length());
+			REQUIRE_EQ(jaggedArray.length(), 10);
+
+			for(unsigned i = 0; i < arrayVector.length(); ++i) {
+				auto& array = arrayVector[i];
+				auto row = jaggedArray.row(i);
+				REQUIRE_EQ(jaggedArray.rowLength(i), array.length());
+				REQUIRE_EQ(row.length(), array.length());
+				for(unsigned j = 0; j < array.length(); ++j) {
+					REQUIRE_EQ(row[j], array[j]);
+				}
+			}
+			REQUIRE_EQ(jaggedArray.rowStart(1), 3);
+			REQUIRE_EQ(jaggedArray.rowLength(2), 0);
+			REQUIRE_EQ(jaggedArray.row(2).length(), 0);
+
+			// Iterate all elements in sequence
+			float expected = 1;
+			for(auto v : jaggedArray) {
+				REQUIRE_EQ(v, expected);
+				++expected;
+			}
+			REQUIRE_EQ(expected, 11);
+
+			float buffer[10]{};
+			REQUIRE_EQ(jaggedArray.readRow(1, buffer, ARRAY_SIZE(buffer)), 7);
+			REQUIRE(buffer[0] == 4 && buffer[6] == 10);
+			REQUIRE_EQ(jaggedArray.readRow(0, buffer, 2), 2);
+			REQUIRE(buffer[0] == 1 && buffer[1] == 2);
+			REQUIRE_EQ(jaggedArray.readRow(2, buffer, ARRAY_SIZE(buffer)), 0);
+
+			DEFINE_FSTR_JAGGED_ARRAY_LOCAL(bytes, uint8_t, (1, 0, 2), 1, 2, 3);
+			REQUIRE(printToString(bytes) == "{{1}, {}, {2, 3}}");
+
+			// Element size does not divide word size
+			struct Rgb {
+				uint8_t r, g, b;
+			};
+			static_assert(sizeof(Rgb) == 3, "Bad Rgb size");
+			DEFINE_FSTR_JAGGED_ARRAY_LOCAL(colours, Rgb, (2, 3), {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12},
+										   {13, 14, 15});
+			REQUIRE_EQ(colours.rows(), 2);
+			REQUIRE_EQ(colours.rowLength(0), 2);
+			REQUIRE_EQ(colours.rowLength(1), 3);
+			REQUIRE_EQ(colours.rowStart(1), 2);
+			auto lastRow = colours.row(1);
+			Rgb last = lastRow[2];
+			REQUIRE(last.r == 13 && last.g == 14 && last.b == 15);
+		}
+
+		TEST_CASE("Packed structures")
+		{
+			struct Rgb {
+				uint8_t r, g, b;
+			};
+			static_assert(sizeof(Rgb) == 3, "Bad Rgb size");
+			DEFINE_FSTR_ARRAY_LOCAL(colours, Rgb, {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}, {13, 14, 15});
+			unsigned n = 1;
+			for(auto c : colours) {
+				REQUIRE(c.r == n && c.g == n + 1 && c.b == n + 2);
+				n += 3;
+			}
+
+			struct Record6 {
+				uint16_t id;
+				uint32_t value;
+			} FSTR_PACKED;
+			DEFINE_FSTR_ARRAY_LOCAL(records6, Record6, {1, 0x11111111}, {2, 0x22222222}, {3, 0x33333333});
+			for(unsigned i = 0; i < records6.length(); ++i) {
+				auto rec = records6[i];
+				REQUIRE_EQ(rec.id, i + 1);
+				REQUIRE_EQ(rec.value, 0x11111111U * (i + 1));
+			}
+
+			struct Record10 {
+				uint32_t a;
+				uint16_t b;
+				uint32_t c;
+			} FSTR_PACKED;
+			DEFINE_FSTR_ARRAY_LOCAL(records10, Record10, {1, 2, 3}, {4, 5, 6}, {7, 8, 9});
+			for(unsigned i = 0; i < records10.length(); ++i) {
+				auto rec = records10[i];
+				REQUIRE(rec.a == i * 3 + 1 && rec.b == i * 3 + 2 && rec.c == i * 3 + 3);
+			}
+
+			// Check all combinations of alignment and size
+			DEFINE_FSTR_ARRAY_LOCAL(bytes, uint8_t, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+			LOAD_FSTR_ARRAY(expected, bytes);
+			for(unsigned offset = 0; offset < 4; ++offset) {
+				for(unsigned size = 0; size <= 12; ++size) {
+					uint8_t buffer[16]{};
+					FSTR::readUnaligned(buffer, bytes.data() + offset, size);
+					REQUIRE(memcmp(buffer, &expected[offset], size) == 0);
+					REQUIRE(buffer[size] == 0);
+				}
+			}
+		}
+
+		TEST_CASE("Field projection")
+		{
+			struct Record {
+				uint16_t id;
+				uint8_t flags;
+				int32_t value; // Unaligned
+				char tag;
+			} FSTR_PACKED;
+			DEFINE_FSTR_ARRAY_LOCAL(records, Record,	 //
+									{12, 1, -100, 'a'}, //
+									{7, 2, 2000, 'b'},	 //
+									{31, 3, 5, 'c'},	 //
+									{3, 4, -7, 'd'});
+
+			auto ids = records.project<&Record::id>();
+			REQUIRE_EQ(ids.length(), records.length());
+			REQUIRE_EQ(ids.indexOf(31), 2);
+			REQUIRE_EQ(ids.indexOf(99), -1);
+			REQUIRE_EQ(ids.min(), 3);
+			REQUIRE_EQ(ids.max(), 31);
+			REQUIRE_EQ(ids[1], 7);
+			REQUIRE_EQ(ids[4], 0);
+			REQUIRE(printToString(ids) == "{12, 7, 31, 3}");
+
+			auto values = records.project<&Record::value>();
+			REQUIRE_EQ(values.min(), -100);
+			REQUIRE_EQ(values.max(), 2000);
+			REQUIRE_EQ(values.indexOf(-7), 3);
+			int32_t buffer[4]{};
+			REQUIRE_EQ(values.read(1, buffer, 10), 3);
+			REQUIRE(buffer[0] == 2000 && buffer[1] == 5 && buffer[2] == -7);
+
+			String tags;
+			for(auto c : records.project<&Record::tag>()) {
+				tags += c;
+			}
+			REQUIRE(tags == "abcd");
+
+			for(unsigned i = 0; i < records.length(); ++i) {
+				auto rec = records[i];
+				REQUIRE_EQ(records.project<&Record::flags>()[i], rec.flags);
+				REQUIRE_EQ(values[i], rec.value);
+			}
+
+			// Aligned fields
+			REQUIRE_EQ(basket.project<&Item::count>().max(), 12);
+			REQUIRE_EQ(basket.project<&Item::kind>().indexOf(Fruit::kiwi_fruit), 2);
+			REQUIRE_EQ(basket.project<&Item::size>()[1].cx, 20);
+		}
+
 		TEST_CASE("IMPORT_FSTR_ARRAY")
 		{
 			Serial << custom_bin << endl;
@@ -178,12 +384,95 @@ public:
 			REQUIRE(item.count == 0);
 		}
 
+		TEST_CASE("Formatted print")
+		{
+			FSTR::PrintFormat format;
+			REQUIRE(printToString(formatArray.printer(format)) == printToString(formatArray));
+			REQUIRE(printToString(formatArray) == "{0, 10, -5, 255}");
+
+			format.radix = 16;
+			format.width = 2;
+			format.fill = '0';
+			REQUIRE(printToString(formatArray.printer(format)) == "{00, 0a, fffffffb, ff}");
+
+			format.radix = 10;
+			format.width = 4;
+			REQUIRE(printToString(formatArray.printer(format)) == "{0000, 0010, -005, 0255}");
+
+			format.fill = ' ';
+			format.prefix = "[";
+			format.suffix = "]";
+			format.separator = ",";
+			REQUIRE(printToString(formatArray.printer(format)) == "[   0,  10,  -5, 255]");
+
+			format = FSTR::PrintFormat{};
+			format.itemsPerLine = 2;
+			format.indent = "  ";
+			REQUIRE(printToString(formatArray.printer(format)) == "{\r\n  0, 10,\r\n  -5, 255\r\n}");
+
+			format = FSTR::PrintFormat{};
+			format.precision = 3;
+			REQUIRE(printToString(formatDoubleArray.printer(format)) == "{1.500, -2.250}");
+			REQUIRE(printToString(tableArray[1].printer(format)) == "{4.000, 5.000, 6.000}");
+
+			format = FSTR::PrintFormat{};
+			format.quote = '"';
+			format.keySeparator = ": ";
+			REQUIRE(printToString(stringVector.printer(format)) == "{\"Test string #1\", \"\", \"Test string #2\"}");
+
+			String text;
+			String quotedText;
+			text += "{\r\n";
+			quotedText += '{';
+			for(auto pair : stringMap) {
+				text += "  ";
+				text += pair.key();
+				text += " => ";
+				text += pair.content();
+				text += "\r\n";
+				if(quotedText.length() > 1) {
+					quotedText += ", ";
+				}
+				quotedText += '"';
+				quotedText += pair.key();
+				quotedText += "\": \"";
+				quotedText += pair.content();
+				quotedText += '"';
+			}
+			text += '}';
+			quotedText += '}';
+			REQUIRE(printToString(stringMap) == text);
+			REQUIRE(printToString(stringMap.printer(format)) == quotedText);
+
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_MAP_LOCAL(sparseMap, int, FSTR::String, {1, &one}, {2, nullptr});
+			REQUIRE(printToString(sparseMap) == "{\r\n  1 => one\r\n  (invalid)\r\n}");
+
+			// Character keys are printed unescaped, as by MapPair
+			DEFINE_FSTR_MAP_LOCAL(charMap, char, FSTR::String, {'a', &one}, {'\'', &one});
+			REQUIRE(printToString(charMap) == "{\r\n  a => one\r\n  ' => one\r\n}");
+			REQUIRE(printToString(charMap.printer(format)) == "{\"a\": \"one\", \"'\": \"one\"}");
+		}
+
 		TEST_CASE("in-class")
 		{
 			REQUIRE_EQ(InClassTest::localData[0], 10);
 			REQUIRE_EQ(InClassTest::localData[4], 50);
 			REQUIRE_EQ(InClassTest::localData[5], 0);
 		}
+
+		TEST_CASE("null and empty")
+		{
+			DEFINE_FSTR_LOCAL(emptyString, "");
+			auto& emptyArray = emptyString.as<FSTR::Array<char>>();
+			auto& nullArray = FSTR::Array<char>::empty();
+			REQUIRE(nullArray.isNull());
+			REQUIRE(!emptyArray.isNull());
+			REQUIRE_EQ(emptyArray.length(), 0U);
+			REQUIRE(emptyArray == emptyArray);
+			REQUIRE(!(emptyArray == nullArray));
+			REQUIRE(!(nullArray == emptyArray));
+		}
 	}
 };
 
@@ -0,0 +1,52 @@
+/**
+ * capture.h - Print helpers for checking output
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include <Print.h>
+#include <WString.h>
+
+/*
+ * Captures output and counts write calls
+ */
+class CapturePrint : public Print
+{
+public:
+	size_t write(uint8_t c) override
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* buffer, size_t size) override
+	{
+		++writeCount;
+		content += String(reinterpret_cast<const char*>(buffer), size);
+		return size;
+	}
+
+	String content;
+	unsigned writeCount{0};
+};
+
+template <class T> String printToString(const T& object)
+{
+	CapturePrint capture;
+	object.printTo(capture);
+	return capture.content;
+}
@@ -35,6 +35,15 @@ DEFINE_FSTR(externalFSTR1, EXTERNAL_FSTR1_TEXT)
 DEFINE_FSTR_ARRAY(doubleArray, double, PI, 53.0, 100, 1e8, 47);
 DEFINE_FSTR_ARRAY(int64Array, int64_t, 1, 2, 3, 4, 5);
 DEFINE_FSTR_ARRAY(tableArray, TableRow_Float_3, {1, 2, 3}, {4, 5, 6}, {7, 8, 9});
+DEFINE_FSTR_TABLE(intTable, int16_t, 3, 4, //
+				  1, 2, 3, 4,			   //
+				  5, 6, 7, 8,			   //
+				  9, 10, 11, 12);
+DEFINE_FSTR_COLUMNAR_TABLE(columnarIntTable, int16_t, 3, 4, //
+						   1, 5, 9,							//
+						   2, 6, 10,						//
+						   3, 7, 11,						//
+						   4, 8, 12);
 
 /**
  * Vector
@@ -48,6 +57,21 @@ DEFINE_FSTR_ARRAY_LOCAL(row1, float, 1, 2, 3);
 DEFINE_FSTR_ARRAY_LOCAL(row2, float, 4, 5, 6, 7, 8, 9, 10);
 DEFINE_FSTR_VECTOR(arrayVector, FSTR::Array<float>, &row1, &row2);
 
+// Same content as `arrayVector`, stored in a single object
+DEFINE_FSTR_JAGGED_ARRAY(jaggedArray, float, (3, 7), 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+
+/**
+ * FrontCodedStringSet
+ */
+
+DEFINE_FSTR_FRONT_CODED_SET(pathSet,											 //
+							"wifi.sta.ssid", "wifi.sta.password", "wifi.sta.dhcp",				 //
+							"wifi.ap.ssid", "wifi.ap.password", "wifi.ap.channel",				 //
+							"mqtt.host", "mqtt.port", "mqtt.user", "mqtt.password",				 //
+							"/www/index.html", "/www/css/style.css", "/www/js/app.js",			 //
+							"/www/favicon.ico", "/www/img/logo.png", "/www/img/banner.png",		 //
+							"/www/img/icons/wifi.svg", "/www/img/icons/mqtt.svg", "wifi.sta.ssid");
+
 /**
  * Map
  */
@@ -62,10 +86,71 @@ IMPORT_FSTR_LOCAL(FS_content1, COMPONENT_PATH "/files/content1.txt");
 IMPORT_FSTR_LOCAL(FS_content2, COMPONENT_PATH "/files/content2.txt");
 DEFINE_FSTR_MAP(stringMap, FSTR::String, FSTR::String, {&key1, &FS_content1}, {&key2, &FS_content2});
 
+DEFINE_FSTR_INLINE_KEY_MAP(inlineStringMap, FSTR::String, {"key1", &FS_content1}, {"key2", &FS_content2});
+
 DEFINE_FSTR_MAP(enumMap, MapKey, FSTR::String, {KeyA, &FS_content1}, {KeyB, &FS_content2});
 
+DEFINE_FSTR_MULTI_MAP(multiEnumMap, MapKey, FSTR::String, {KeyB, &FS_content2}, {KeyA, &FS_content1},
+					  {KeyB, &FS_content1});
+
+// Map of `RegisterKey => String`
+
+DEFINE_FSTR_LOCAL(regTemperature, "temperature");
+DEFINE_FSTR_LOCAL(regHumidity, "humidity");
+DEFINE_FSTR_LOCAL(regState, "state");
+DEFINE_FSTR_LOCAL(regBrightness, "brightness");
+DEFINE_FSTR_LOCAL(regContrast, "contrast");
+
+#define REGISTER_MAP(XX)                                                                                               \
+	XX(display, 2, regContrast)                                                                                        \
+	XX(sensor, 2, regHumidity)                                                                                         \
+	XX(relay, 1, regState)                                                                                             \
+	XX(display, 1, regBrightness)                                                                                      \
+	XX(sensor, 1, regTemperature)
+
+#define XX(device, reg, content) {{DeviceType::device, reg}, &content},
+DEFINE_FSTR_MAP(registerMap, RegisterKey, FSTR::String, REGISTER_MAP(XX));
+DEFINE_FSTR_MULTI_MAP(sortedRegisterMap, RegisterKey, FSTR::String, REGISTER_MAP(XX));
+#undef XX
+
+DEFINE_FSTR_COLUMNAR_MAP(columnarEnumMap, MapKey, FSTR::String, (KeyA, KeyB), (&FS_content1, &FS_content2));
+
 DEFINE_FSTR_MAP(vectorMap, FSTR::String, FSTR::Vector<FSTR::String>, {&key1, &stringVector});
 
+/**
+ * PathIndex
+ */
+
+// Flattened view of `vectorMap` and `arrayMap` plus imported files
+DEFINE_FSTR_PATH_INDEX(pathIndex,									  //
+					   {"vectorMap/key1/0", &data1},				  //
+					   {"vectorMap/key1/2", &data2},				  //
+					   {"arrayMap/1", &row1},						  //
+					   {"arrayMap/2", &row2},						  //
+					   {"files/content1.txt", &FS_content1},		  //
+					   {"files/content2.txt", &FS_content2});
+
+/**
+ * FileMap
+ *
+ * Generated using `tools/filemap.py --name fileMap --base-var COMPONENT_PATH --base-path test test/files`
+ */
+
+DEFINE_FSTR_LOCAL(fileMap_mime0, "text/plain")
+DEFINE_FSTR_LOCAL(fileMap_mime1, "application/octet-stream")
+
+IMPORT_FSTR_LOCAL(fileMap_data0, COMPONENT_PATH "/files/content1.txt")
+DEFINE_FSTR_FILE_LOCAL(fileMap_file0, fileMap_data0, fileMap_mime0, 1718962404, 0x77b809f4)
+IMPORT_FSTR_LOCAL(fileMap_data1, COMPONENT_PATH "/files/content2.txt")
+DEFINE_FSTR_FILE_LOCAL(fileMap_file1, fileMap_data1, fileMap_mime0, 1718962404, 0xcb5ac88d)
+IMPORT_FSTR_LOCAL(fileMap_data2, COMPONENT_PATH "/files/custom.bin")
+DEFINE_FSTR_FILE_LOCAL(fileMap_file2, fileMap_data2, fileMap_mime1, 1718962404, 0x7c60f1bf)
+
+DEFINE_FSTR_FILE_MAP(fileMap,						 //
+					 {"content1.txt", &fileMap_file0}, //
+					 {"content2.txt", &fileMap_file1}, //
+					 {"custom.bin", &fileMap_file2});
+
 /**
  * Speed
  */
@@ -513,6 +598,33 @@ LARGE_STRING_MAP(XX)
 DEFINE_FSTR_VECTOR(largeStringVector, FSTR::String, LARGE_STRING_MAP(XX))
 #undef XX
 
+#define XX(i, s) s,
+DEFINE_FSTR_FRONT_CODED_SET(largeStringSet, LARGE_STRING_MAP(XX))
+#undef XX
+
 #define XX(i, s) {i, &STR_##i},
 DEFINE_FSTR_MAP(largeStringMap, int, FSTR::String, LARGE_STRING_MAP(XX))
 #undef XX
+
+#define KEY(i, s) i,
+#define CONTENT(i, s) &STR_##i,
+DEFINE_FSTR_COLUMNAR_MAP(largeColumnarMap, uint16_t, FSTR::String, (LARGE_STRING_MAP(KEY)), (LARGE_STRING_MAP(CONTENT)))
+#undef CONTENT
+#undef KEY
+
+#define XX(i, s) {&STR_##i, &STR_##i},
+DEFINE_FSTR_MAP(largeStringKeyMap, FSTR::String, FSTR::String, LARGE_STRING_MAP(XX))
+#undef XX
+
+#define XX(i, s) {s, &STR_##i},
+DEFINE_FSTR_INLINE_KEY_MAP(largeInlineKeyMap, FSTR::String, LARGE_STRING_MAP(XX))
+#undef XX
+
+// Strings keyed by length
+#define XX(i, s) {sizeof(s) - 1, &STR_##i},
+DEFINE_FSTR_MULTI_MAP(largeMultiMap, uint8_t, FSTR::String, LARGE_STRING_MAP(XX))
+#undef XX
+
+#define XX(i, s) {"words/" #i, &STR_##i},
+DEFINE_FSTR_PATH_INDEX(largePathIndex, LARGE_STRING_MAP(XX))
+#undef XX
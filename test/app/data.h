@@ -24,8 +24,17 @@
 #include <FlashString/String.hpp>
 #include <FlashString/Array.hpp>
 #include <FlashString/Table.hpp>
+#include <FlashString/JaggedArray.hpp>
 #include <FlashString/Vector.hpp>
 #include <FlashString/Map.hpp>
+#include <FlashString/FrontCodedStringSet.hpp>
+#include <FlashString/ColumnarMap.hpp>
+#include <FlashString/InlineKeyMap.hpp>
+#include <FlashString/MapReverseIndex.hpp>
+#include <FlashString/MultiMap.hpp>
+#include <FlashString/PathIndex.hpp>
+#include <FlashString/FileMap.hpp>
+#include <FlashString/BufferedStream.hpp>
 
 /**
  * String
@@ -43,6 +52,9 @@ DECLARE_FSTR_ARRAY(int64Array, int64_t);
 
 using TableRow_Float_3 = FSTR::TableRow<float, 3>;
 DECLARE_FSTR_ARRAY(tableArray, TableRow_Float_3);
+DECLARE_FSTR_TABLE(intTable, int16_t, 3, 4);
+DECLARE_FSTR_COLUMNAR_TABLE(columnarIntTable, int16_t, 3, 4);
+DECLARE_FSTR_JAGGED_ARRAY(jaggedArray, float);
 
 /**
  * Vector
@@ -51,6 +63,12 @@ DECLARE_FSTR_ARRAY(tableArray, TableRow_Float_3);
 DECLARE_FSTR_VECTOR(stringVector, FSTR::String);
 DECLARE_FSTR_VECTOR(arrayVector, FSTR::Array<float>);
 
+/**
+ * FrontCodedStringSet
+ */
+
+DECLARE_FSTR_FRONT_CODED_SET(pathSet);
+
 /**
  * Map
  */
@@ -65,10 +83,73 @@ DECLARE_FSTR_MAP(enumMap, MapKey, FSTR::String);
 DECLARE_FSTR_MAP(stringMap, FSTR::String, FSTR::String);
 DECLARE_FSTR_MAP(arrayMap, int, FSTR::Array<float>);
 DECLARE_FSTR_MAP(vectorMap, FSTR::String, FSTR::Vector<FSTR::String>);
+DECLARE_FSTR_COLUMNAR_MAP(columnarEnumMap, MapKey, FSTR::String);
+DECLARE_FSTR_INLINE_KEY_MAP(inlineStringMap, FSTR::String);
+DECLARE_FSTR_MULTI_MAP(multiEnumMap, MapKey, FSTR::String);
+
+// Composite key
+enum class DeviceType : uint16_t {
+	sensor = 1,
+	relay = 2,
+	display = 3,
+};
+
+struct RegisterKey {
+	DeviceType device;
+	uint16_t reg;
+
+	constexpr bool operator==(const RegisterKey& other) const
+	{
+		return device == other.device && reg == other.reg;
+	}
+
+	constexpr bool operator<(const RegisterKey& other) const
+	{
+		return device < other.device || (device == other.device && reg < other.reg);
+	}
+
+	size_t printTo(Print& p) const
+	{
+		size_t n{0};
+		n += p.print('{');
+		n += p.print(unsigned(device));
+		n += p.print(", ");
+		n += p.print(reg);
+		n += p.print('}');
+		return n;
+	}
+};
+
+// Comparisons with partial key
+constexpr bool operator<(const RegisterKey& key, DeviceType device)
+{
+	return key.device < device;
+}
+
+constexpr bool operator<(DeviceType device, const RegisterKey& key)
+{
+	return device < key.device;
+}
+
+DECLARE_FSTR_MAP(registerMap, RegisterKey, FSTR::String);
+DECLARE_FSTR_MULTI_MAP(sortedRegisterMap, RegisterKey, FSTR::String);
+
+/**
+ * PathIndex
+ */
+
+DECLARE_FSTR_PATH_INDEX(pathIndex);
+DECLARE_FSTR_FILE_MAP(fileMap);
 
 /**
  * Speed
  */
 DECLARE_FSTR_ARRAY(largeIntArray, int)
 DECLARE_FSTR_VECTOR(largeStringVector, FSTR::String)
+DECLARE_FSTR_FRONT_CODED_SET(largeStringSet)
 DECLARE_FSTR_MAP(largeStringMap, int, FSTR::String)
+DECLARE_FSTR_COLUMNAR_MAP(largeColumnarMap, uint16_t, FSTR::String)
+DECLARE_FSTR_MAP(largeStringKeyMap, FSTR::String, FSTR::String)
+DECLARE_FSTR_INLINE_KEY_MAP(largeInlineKeyMap, FSTR::String)
+DECLARE_FSTR_MULTI_MAP(largeMultiMap, uint8_t, FSTR::String)
+DECLARE_FSTR_PATH_INDEX(largePathIndex)
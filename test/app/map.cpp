@@ -75,6 +75,33 @@ public:
 			}
 		}
 
+		TEST_CASE("InlineKeyMap of String => String")
+		{
+			Serial << inlineStringMap << endl;
+
+			REQUIRE_EQ(inlineStringMap.length(), stringMap.length());
+			unsigned i{0};
+			for(auto pair : inlineStringMap) {
+				REQUIRE(pair.key() == stringMap.valueAt(i).key());
+				REQUIRE(inlineStringMap.valueAt(i).key() == pair.key());
+				REQUIRE(pair.content() == stringMap.valueAt(i).content());
+				++i;
+			}
+
+			REQUIRE_EQ(inlineStringMap.indexOf("key2"), 1);
+			REQUIRE_EQ(inlineStringMap.indexOf("KEY2"), 1);
+			REQUIRE_EQ(inlineStringMap.indexOf("KEY2", false), -1);
+			REQUIRE_EQ(inlineStringMap.indexOf(F("key1")), 0);
+			REQUIRE(inlineStringMap["key1"].content() == stringMap["key1"].content());
+			REQUIRE(!inlineStringMap["key20"]);
+
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_LOCAL(two, "two");
+			DEFINE_FSTR_INLINE_KEY_MAP_LOCAL(localMap, FSTR::String, {"a", &one}, {"bb", &two});
+			REQUIRE_EQ(localMap.length(), 2U);
+			REQUIRE(localMap["BB"].content() == "two");
+		}
+
 		TEST_CASE("Map[0] as Array<int64>")
 		{
 			auto& arr = stringMap.valueAt(0).content().as<FSTR::Array<int64_t>>();
@@ -102,6 +129,211 @@ public:
 			Serial << _F("  enumMap[C]: ") << enumMap[KeyC] << endl;
 		}
 
+		TEST_CASE("ColumnarMap of enum MapKey => String")
+		{
+			Serial << columnarEnumMap << endl;
+
+			REQUIRE_EQ(columnarEnumMap.length(), enumMap.length());
+			for(unsigned i = 0; i < enumMap.length(); ++i) {
+				REQUIRE_EQ(columnarEnumMap.keyAt(i), enumMap.valueAt(i).key());
+				REQUIRE(columnarEnumMap.valueAt(i).content() == enumMap.valueAt(i).content());
+			}
+
+			unsigned count{0};
+			for(auto pair : columnarEnumMap) {
+				REQUIRE(pair);
+				++count;
+			}
+			REQUIRE_EQ(count, columnarEnumMap.length());
+
+			REQUIRE_EQ(columnarEnumMap.indexOf(KeyA), 0);
+			REQUIRE_EQ(columnarEnumMap.indexOf(KeyB), 1);
+			REQUIRE_EQ(columnarEnumMap.indexOf(KeyC), -1);
+			// Key block is padded with zeroes, make sure these don't match
+			REQUIRE_EQ(columnarEnumMap.indexOf(MapKey(0)), -1);
+			REQUIRE(columnarEnumMap[KeyB].content() == enumMap[KeyB].content());
+			REQUIRE(!columnarEnumMap[KeyC]);
+
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_LOCAL(two, "two");
+			DEFINE_FSTR_COLUMNAR_MAP_LOCAL(localMap, uint8_t, FSTR::String, (1, 2, 3), (&one, &two, nullptr));
+			REQUIRE_EQ(localMap.length(), 3U);
+			REQUIRE(localMap[2].content() == "two");
+			REQUIRE(!localMap[3]);
+		}
+
+		TEST_CASE("MultiMap of enum MapKey => String")
+		{
+			Serial << multiEnumMap << endl;
+
+			REQUIRE_EQ(multiEnumMap.length(), 3U);
+			REQUIRE_EQ(multiEnumMap.valueAt(0).key(), KeyA);
+			REQUIRE_EQ(multiEnumMap.count(KeyA), 1U);
+			REQUIRE_EQ(multiEnumMap.count(KeyB), 2U);
+			REQUIRE_EQ(multiEnumMap.count(KeyC), 0U);
+
+			auto range = multiEnumMap.equal_range(KeyB);
+			REQUIRE_EQ(range.length(), 2U);
+			REQUIRE_EQ(range.index(), 1U);
+			// Entries with equal keys retain definition order
+			REQUIRE(range[0].content() == enumMap[KeyB].content());
+			REQUIRE(range[1].content() == enumMap[KeyA].content());
+			for(auto pair : range) {
+				REQUIRE_EQ(pair.key(), KeyB);
+			}
+
+			REQUIRE(!multiEnumMap.equal_range(KeyC));
+			REQUIRE_EQ(multiEnumMap.indexOf(KeyB), 1);
+			REQUIRE_EQ(multiEnumMap.indexOf(KeyC), -1);
+			REQUIRE(multiEnumMap[KeyA].content() == enumMap[KeyA].content());
+
+			for(unsigned len = 0; len < 20; ++len) {
+				unsigned count{0};
+				for(auto& s : largeStringVector) {
+					if(s.length() == len) {
+						++count;
+					}
+				}
+				auto range = largeMultiMap.equal_range(len);
+				REQUIRE_EQ(range.length(), count);
+				REQUIRE_EQ(largeMultiMap.count(len), count);
+				for(auto pair : range) {
+					REQUIRE_EQ(pair.content().length(), len);
+				}
+			}
+
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_LOCAL(two, "two");
+			DEFINE_FSTR_MULTI_MAP_LOCAL(localMap, int, FSTR::String, {2, &two}, {1, &one}, {2, &one});
+			REQUIRE_EQ(localMap.count(2), 2U);
+			REQUIRE(localMap.valueAt(0).content() == "one");
+		}
+
+		TEST_CASE("Map of composite RegisterKey => String")
+		{
+			Serial << registerMap << endl;
+			Serial << sortedRegisterMap << endl;
+
+			constexpr RegisterKey sensor1{DeviceType::sensor, 1};
+			constexpr RegisterKey sensor2{DeviceType::sensor, 2};
+			constexpr RegisterKey sensor3{DeviceType::sensor, 3};
+			constexpr RegisterKey relay1{DeviceType::relay, 1};
+			constexpr RegisterKey relay2{DeviceType::relay, 2};
+
+			REQUIRE_EQ(registerMap.indexOf(sensor1), 4);
+			REQUIRE_EQ(registerMap.indexOf(sensor3), -1);
+			REQUIRE(registerMap[relay1].content() == "state");
+			REQUIRE(registerMap.valueAt(1).key() == sensor2);
+
+			// Sorted layout
+			REQUIRE_EQ(sortedRegisterMap.length(), registerMap.length());
+			for(unsigned i = 1; i < sortedRegisterMap.length(); ++i) {
+				REQUIRE(sortedRegisterMap.valueAt(i - 1).key() < sortedRegisterMap.valueAt(i).key());
+			}
+			for(auto pair : registerMap) {
+				REQUIRE(sortedRegisterMap[pair.key()].content() == pair.content());
+			}
+			REQUIRE(!sortedRegisterMap[relay2]);
+
+			// Partial key
+			auto range = sortedRegisterMap.equal_range(DeviceType::display);
+			REQUIRE_EQ(range.length(), 2U);
+			REQUIRE(range[0].content() == "brightness");
+			REQUIRE(range[1].content() == "contrast");
+			REQUIRE_EQ(sortedRegisterMap.count(DeviceType::sensor), 2U);
+			REQUIRE_EQ(sortedRegisterMap.indexOf(DeviceType::relay), 2);
+		}
+
+		TEST_CASE("PathIndex")
+		{
+			REQUIRE_EQ(pathIndex.length(), 6U);
+			for(unsigned i = 0; i < pathIndex.length(); ++i) {
+				auto& path = pathIndex.pathAt(i);
+				Serial << _F("  pathIndex[") << i << "]: " << path << endl;
+				REQUIRE_EQ(pathIndex.indexOf(String(path)), int(i));
+			}
+
+			auto& vec = vectorMap["key1"].content();
+			REQUIRE(pathIndex.resolve<FSTR::String>("vectorMap/key1/0") == vec[0]);
+			REQUIRE(pathIndex.resolve<FSTR::String>("vectorMap/key1/2") == vec[2]);
+			REQUIRE(pathIndex.resolve<FSTR::String>("vectorMap/key1/1").isNull());
+			REQUIRE(pathIndex.resolve<FSTR::Array<float>>("arrayMap/2") == arrayMap[2].content());
+			REQUIRE(pathIndex.resolve<FSTR::String>(F("files/content1.txt")) == stringMap["key1"].content());
+			REQUIRE_EQ(pathIndex.indexOf("files/content1"), -1);
+			REQUIRE_EQ(pathIndex.indexOf("FILES/content1.txt"), -1);
+
+			for(unsigned i = 0; i < largeStringVector.length(); ++i) {
+				String path = F("words/") + String(i);
+				REQUIRE(&largePathIndex.resolve<FSTR::String>(path) == &largeStringVector[i]);
+			}
+
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_LOCAL(two, "two");
+			DEFINE_FSTR_PATH_INDEX_LOCAL(localIndex, {"a/b", &one}, {"a/c", &two});
+			REQUIRE_EQ(localIndex.length(), 2U);
+			REQUIRE(localIndex.resolve<FSTR::String>("a/b") == "one");
+		}
+
+		TEST_CASE("FileMap")
+		{
+			REQUIRE_EQ(fileMap.length(), 3U);
+
+			auto& file = fileMap.stat("content1.txt");
+			REQUIRE(!file.isNull());
+			REQUIRE(file.content() == stringMap["key1"].content());
+			REQUIRE_EQ(file.size(), stringMap["key1"].content().length());
+			REQUIRE(file.mimeType() == "text/plain");
+			REQUIRE_EQ(file.etag(), file.content().hash());
+			REQUIRE(fileMap.stat("custom.bin").mimeType() == "application/octet-stream");
+
+			REQUIRE(fileMap.stat("missing.txt").isNull());
+			REQUIRE(!fileMap.exists("missing.txt"));
+			REQUIRE(fileMap.open("missing.txt") == nullptr);
+
+			for(unsigned i = 0; i < fileMap.length(); ++i) {
+				auto& f = fileMap.fileAt(i);
+				REQUIRE_EQ(f.etag(), f.content().hash());
+			}
+
+			auto stream = fileMap.open(F("content2.txt"));
+			REQUIRE(stream != nullptr);
+			REQUIRE(stream->getName() == "content2.txt");
+			char etag[11];
+			REQUIRE(stream->id() == fileMap.stat("content2.txt").getETag(etag));
+			Serial << _F("content2.txt ETag ") << etag << endl;
+			char buffer[256];
+			String content;
+			while(!stream->isFinished()) {
+				auto n = stream->readBytes(buffer, 7);
+				content += String(buffer, n);
+			}
+			REQUIRE(content == String(stringMap["key2"].content()));
+			delete stream;
+		}
+
+		TEST_CASE("Reverse lookup")
+		{
+			REQUIRE_EQ(stringMap.indexOfContent(stringMap.valueAt(1).content()), 1);
+			REQUIRE_EQ(stringMap.indexOfContent(FS("This is content from file \"content2.txt\".")), 1);
+			REQUIRE_EQ(stringMap.indexOfContent(FS("Not in map")), -1);
+
+			FSTR::MapReverseIndex<FSTR::Map<int, FSTR::String>> index(largeStringMap, true);
+			REQUIRE_EQ(index.length(), largeStringMap.length());
+			for(unsigned i = 0; i < largeStringVector.length(); ++i) {
+				REQUIRE_EQ(index.keyOf(largeStringVector[i]), int(i));
+			}
+
+			// Duplicate content at different addresses resolves to first matching entry
+			REQUIRE_EQ(index.indexOf(FS("the")), largeStringMap.indexOfContent(FS("the")));
+			REQUIRE_EQ(index.keyOf(FS("Components/*/index")), 366);
+			REQUIRE(!index[FS("Not in map")]);
+
+			FSTR::MapReverseIndex<FSTR::InlineKeyMap<FSTR::String>> addressIndex(inlineStringMap);
+			REQUIRE(!addressIndex.hasHashes());
+			REQUIRE(addressIndex.keyOf(stringMap.valueAt(0).content()) == "key1");
+			REQUIRE_EQ(addressIndex.indexOf(FS("This is content from file \"content2.txt\".")), -1);
+		}
+
 		TEST_CASE("Map of String => Vector<String>")
 		{
 			Serial << _F("vectorMap[") << vectorMap.length() << ']' << endl;
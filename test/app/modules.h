@@ -6,4 +6,5 @@
 	XX(vector)                                                                                                         \
 	XX(map)                                                                                                            \
 	XX(custom)                                                                                                         \
+	XX(stream)                                                                                                         \
 	XX(speed)
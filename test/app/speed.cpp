@@ -22,6 +22,20 @@
 #include <SmingTest.h>
 #include "data.h"
 
+#ifdef ENABLE_FS_BENCHMARK
+#include <Storage.h>
+#include <Spiffs.h>
+#include <LittleFS.h>
+#endif
+
+namespace
+{
+// Contents of fileMap, also used to build file system images for comparison
+const char* const benchmarkFiles[]{"content1.txt", "content2.txt", "custom.bin"};
+constexpr int benchmarkFilesSize{134};
+
+} // namespace
+
 class SpeedTest : public TestGroup
 {
 public:
@@ -60,6 +74,105 @@ public:
 		sum(object[value]);
 	}
 
+	static void __noinline profile_stream(IDataSourceStream& stream, size_t blockSize)
+	{
+		char buffer[1024];
+		size_t n;
+		while((n = stream.readBytes(buffer, blockSize)) != 0) {
+			total += n;
+		}
+	}
+
+	static void __noinline profile_file_read(const char* path)
+	{
+		auto stream = fileMap.open(path);
+		profile_stream(*stream, 64);
+		delete stream;
+	}
+
+#ifdef ENABLE_FS_BENCHMARK
+	static void __noinline profile_file_read(IFS::IFileSystem& fs, const char* path)
+	{
+		auto file = fs.open(path, IFS::OpenFlag::Read);
+		char buffer[64];
+		int n;
+		while((n = fs.read(file, buffer, sizeof(buffer))) > 0) {
+			total += n;
+		}
+		fs.close(file);
+	}
+
+	/*
+	 * Repeat FileMap tests using a file system image built from the same files
+	 */
+	void profile_filesystem(IFS::IFileSystem* fs)
+	{
+		if(fs == nullptr || fs->mount() < 0) {
+			Serial << _F("File system not available") << endl;
+			delete fs;
+			return;
+		}
+
+		Serial << _F("stat: ");
+		timeit(
+			[fs]() {
+				IFS::Stat stat;
+				fs->stat("content2.txt", &stat);
+				total += stat.size;
+			},
+			41);
+
+		Serial << _F("open, read: ");
+		timeit([fs]() { profile_file_read(*fs, "content2.txt"); }, 41);
+
+		Serial << _F("read all files: ");
+		timeit(
+			[fs]() {
+				for(auto path : benchmarkFiles) {
+					profile_file_read(*fs, path);
+				}
+			},
+			benchmarkFilesSize);
+
+		delete fs;
+	}
+#endif
+
+	/*
+	 * Discards output, counting bytes and write calls
+	 */
+	class CountingPrint : public Print
+	{
+	public:
+		size_t write(uint8_t c) override
+		{
+			return write(&c, 1);
+		}
+
+		size_t write(const uint8_t* data, size_t size) override
+		{
+			(void)data;
+			++writeCount;
+			total += size;
+			return size;
+		}
+
+		unsigned writeCount{0};
+	};
+
+	template <typename T> void profile_print(const T& object)
+	{
+		CountingPrint counter;
+		auto expected = object.printTo(counter);
+		Serial << _F("Printed ") << expected << _F(" bytes in ") << counter.writeCount << _F(" write calls") << endl;
+		timeit(
+			[&object]() {
+				CountingPrint counter;
+				object.printTo(counter);
+			},
+			expected);
+	}
+
 	void timeit(Delegate<void()> callback, int expectedTotal)
 	{
 		total = 0;
@@ -132,6 +245,14 @@ public:
 			timeit([]() { profile_indexOf(largeStringVector, F("Components/*/index")); }, 366);
 		}
 
+		Serial << _F("FrontCodedStringSet has ") << largeStringSet.length() << _F(" unique elements, ")
+			   << largeStringSet.size() << _F(" bytes.") << endl;
+
+		TEST_CASE("FrontCodedStringSet indexOf")
+		{
+			timeit([]() { profile_indexOf(largeStringSet, _F("Components/*/index")); }, 38);
+		}
+
 		// Fill cache so comparison is fair
 		profile_iterator(largeStringMap);
 
@@ -154,6 +275,158 @@ public:
 		{
 			timeit([]() { profile_lookup(largeStringMap, 366); }, 18);
 		}
+
+		TEST_CASE("MultiMap<uint8_t, String> equal_range")
+		{
+			timeit([]() { profile_iterator(largeMultiMap.equal_range(18)); }, 18);
+		}
+
+		TEST_CASE("Map<String, Vector<String>> nested lookup")
+		{
+			timeit([]() { sum(vectorMap["key1"].content()[2]); }, 14);
+		}
+
+		TEST_CASE("PathIndex resolve")
+		{
+			timeit([]() { sum(pathIndex.resolve<FSTR::String>("vectorMap/key1/2")); }, 14);
+		}
+
+		TEST_CASE("PathIndex resolve, large")
+		{
+			timeit([]() { sum(largePathIndex.resolve<FSTR::String>("words/366")); }, 18);
+		}
+
+		TEST_CASE("FileMap stat")
+		{
+			timeit([]() { total += fileMap.stat("content2.txt").size(); }, 41);
+		}
+
+		TEST_CASE("FileMap open, read")
+		{
+			timeit([]() { profile_file_read("content2.txt"); }, 41);
+		}
+
+		TEST_CASE("FileMap read all files")
+		{
+			timeit(
+				[]() {
+					for(auto path : benchmarkFiles) {
+						profile_file_read(path);
+					}
+				},
+				benchmarkFilesSize);
+		}
+
+#ifdef ENABLE_FS_BENCHMARK
+		TEST_CASE("SPIFFS")
+		{
+			profile_filesystem(IFS::createSpiffsFilesystem(Storage::findPartition(F("spiffs0"))));
+		}
+
+		TEST_CASE("LittleFS")
+		{
+			profile_filesystem(IFS::createLfsFilesystem(Storage::findPartition(F("lfs0"))));
+		}
+#endif
+
+		TEST_CASE("Stream read")
+		{
+			for(auto blockSize : {1, 7, 32, 100, 256, 1024}) {
+				Serial << _F("Block size ") << blockSize << _F(": ");
+				timeit(
+					[blockSize]() {
+						FSTR::Stream stream(largeIntArray);
+						profile_stream(stream, blockSize);
+					},
+					largeIntArray.size());
+			}
+		}
+
+		TEST_CASE("BufferedStream read")
+		{
+			for(auto blockSize : {1, 7, 32, 100, 256, 1024}) {
+				Serial << _F("Block size ") << blockSize << _F(": ");
+				timeit(
+					[blockSize]() {
+						FSTR::BufferedStream stream(largeIntArray);
+						profile_stream(stream, blockSize);
+					},
+					largeIntArray.size());
+			}
+		}
+
+		TEST_CASE("Array<int> print")
+		{
+			profile_print(largeIntArray);
+		}
+
+		TEST_CASE("Map<int, String> print")
+		{
+			profile_print(largeStringMap);
+		}
+
+		TEST_CASE("Map<int, String> indexOfContent")
+		{
+			timeit([]() { total += largeStringMap.indexOfContent(largeStringVector[366]); }, 366);
+		}
+
+		{
+			FSTR::MapReverseIndex<FSTR::Map<int, FSTR::String>> index(largeStringMap);
+
+			TEST_CASE("MapReverseIndex<Map<int, String>> indexOf")
+			{
+				timeit([&]() { total += index.indexOf(largeStringVector[366]); }, 366);
+			}
+		}
+
+		// Fill cache so comparison is fair
+		profile_iterator(largeStringKeyMap);
+
+		TEST_CASE("Map<String, String> indexOf")
+		{
+			timeit([]() { profile_indexOf(largeStringKeyMap, _F("Components/*/index")); }, 366);
+		}
+
+		TEST_CASE("Map<String, String> lookup")
+		{
+			timeit([]() { profile_lookup(largeStringKeyMap, _F("Components/*/index")); }, 18);
+		}
+
+		// Fill cache so comparison is fair
+		profile_iterator(largeInlineKeyMap);
+
+		TEST_CASE("InlineKeyMap<String> iterator")
+		{
+			timeit([]() { profile_iterator(largeInlineKeyMap); }, 2279);
+		}
+
+		TEST_CASE("InlineKeyMap<String> indexOf")
+		{
+			timeit([]() { profile_indexOf(largeInlineKeyMap, _F("Components/*/index")); }, 366);
+		}
+
+		TEST_CASE("InlineKeyMap<String> lookup")
+		{
+			timeit([]() { profile_lookup(largeInlineKeyMap, _F("Components/*/index")); }, 18);
+		}
+
+		// Fill cache so comparison is fair
+		profile_iterator(largeColumnarMap);
+
+		TEST_CASE("ColumnarMap<uint16_t, String> iterator")
+		{
+			timeit([]() { profile_iterator(largeColumnarMap); }, 2279);
+		}
+
+		TEST_CASE("ColumnarMap<uint16_t, String> indexOf")
+		{
+			timeit([]() { profile_indexOf(largeColumnarMap, 366); }, 366);
+		}
+
+		TEST_CASE("ColumnarMap<uint16_t, String> lookup")
+		{
+			timeit([]() { profile_lookup(largeColumnarMap, 366); }, 18);
+		}
 	}
 
 	static int total;
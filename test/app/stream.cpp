@@ -0,0 +1,644 @@
+/**
+ * stream.cpp - Test stream classes
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include <FlashString/Gzip.hpp>
+#include <FlashString/InflateStream.hpp>
+#include <FlashString/Stream.hpp>
+#include <FlashString/BufferedStream.hpp>
+#include <FlashString/MultiStream.hpp>
+#include <FlashString/RangeStream.hpp>
+#include <FlashString/CompiledTemplate.hpp>
+#include <FlashString/PrintJob.hpp>
+#include <FlashString/BufferedPrint.hpp>
+#include <FlashString/JsonStream.hpp>
+#include <FlashString/BinaryStream.hpp>
+#include <FlashString/CsvStream.hpp>
+#include "data.h"
+#include "capture.h"
+#include <memory>
+
+namespace
+{
+IMPORT_FSTR_LOCAL(licenseText, COMPONENT_PATH "/../LICENSE")
+
+// Compressed using `tools/fstrgzip.py --window-bits 10`
+IMPORT_FSTR_GZIP_LOCAL(licenseGzip, COMPONENT_PATH "/files/license-w10.gz")
+
+// Compressed using standard gzip
+IMPORT_FSTR_GZIP_LOCAL(licenseGzip32K, COMPONENT_PATH "/files/license.gz")
+
+// Generated using `tools/fstrtemplate.py --local --name pageTemplate test/template/page.html`
+DEFINE_FSTR_LOCAL(pageTemplate_text,
+				  "<html>\n"
+				  "<head>\n"
+				  "<title></title>\n"
+				  "<style>body { margin: 0; }</style>\n"
+				  "</head>\n"
+				  "<body>\n"
+				  "<h1></h1>\n"
+				  "<p>Hello , you have  new messages.</p>\n"
+				  "<p></p>\n"
+				  "</body>\n"
+				  "</html>\n")
+
+DEFINE_FSTR_LOCAL(pageTemplate_var0, "title")
+DEFINE_FSTR_LOCAL(pageTemplate_var1, "name")
+DEFINE_FSTR_LOCAL(pageTemplate_var2, "count")
+DEFINE_FSTR_LOCAL(pageTemplate_var3, "missing")
+DEFINE_FSTR_VECTOR_LOCAL(pageTemplate_variables, FSTR::String,
+	&pageTemplate_var0,
+	&pageTemplate_var1,
+	&pageTemplate_var2,
+	&pageTemplate_var3)
+
+DEFINE_FSTR_ARRAY_LOCAL(pageTemplate_fields, FSTR::TemplateField,
+	{21, 0},
+	{84, 0},
+	{99, 1},
+	{110, 2},
+	{132, 3})
+
+DEFINE_FSTR_TEMPLATE_LOCAL(pageTemplate, pageTemplate_text, pageTemplate_variables, pageTemplate_fields)
+
+String readStream(IDataSourceStream& stream, size_t chunkSize)
+{
+	String s;
+	char buffer[256];
+	while(!stream.isFinished()) {
+		auto n = stream.readBytes(buffer, chunkSize);
+		if(n == 0) {
+			break;
+		}
+		s += String(buffer, n);
+	}
+	return s;
+}
+
+/*
+ * Simulates a slow output which accepts a limited amount of data per write
+ */
+class ThrottledPrint : public CapturePrint
+{
+public:
+	size_t write(const uint8_t* buffer, size_t size) override
+	{
+		return CapturePrint::write(buffer, std::min(size, size_t(11)));
+	}
+};
+
+/*
+ * Run a PrintJob to completion in small steps and return the output
+ */
+String runPrintJob(FSTR::PrintJob& job, CapturePrint& output)
+{
+	unsigned steps = 0;
+	while(!job.isFinished()) {
+		job.step(50);
+		++steps;
+	}
+	Serial << _F("PrintJob completed in ") << steps << _F(" steps, ") << job.getWriteCount() << _F(" bytes")
+		   << endl;
+	return output.content;
+}
+
+template <template <class> class Job, class T> String runPrintJob(const T& object)
+{
+	ThrottledPrint output;
+	Job<T> job(output, object);
+	return runPrintJob(job, output);
+}
+
+} // namespace
+
+class StreamTest : public TestGroup
+{
+public:
+	StreamTest() : TestGroup(_F("Streams"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("Direct access")
+		{
+			String text(licenseText);
+			size_t len{0};
+			auto ptr = licenseText.getDirectBuffer(10, 20, len);
+#if FSTR_DIRECT_ACCESS
+			REQUIRE(ptr == licenseText.as<FSTR::ObjectBase>().data() + 10);
+			REQUIRE_EQ(len, 20U);
+			ptr = licenseText.getDirectBuffer(text.length() - 5, 20, len);
+			REQUIRE(ptr != nullptr);
+			REQUIRE_EQ(len, 5U);
+#else
+			REQUIRE(ptr == nullptr);
+#endif
+			REQUIRE(licenseText.getDirectBuffer(text.length(), 20, len) == nullptr);
+
+			FSTR::Stream stream(licenseText);
+			CapturePrint capture;
+			REQUIRE_EQ(stream.writeTo(capture, 100), 100U);
+			REQUIRE_EQ(stream.available(), int(text.length() - 100));
+			REQUIRE_EQ(stream.writeTo(capture), text.length() - 100);
+			REQUIRE(stream.isFinished());
+			REQUIRE(capture.content == text);
+			Serial << _F("Stream::writeTo() used ") << capture.writeCount << _F(" writes") << endl;
+
+			CapturePrint capture2;
+			REQUIRE_EQ(licenseText.printTo(capture2), text.length());
+			REQUIRE(capture2.content == text);
+#if FSTR_DIRECT_ACCESS
+			REQUIRE_EQ(capture2.writeCount, 1U);
+#endif
+		}
+
+		TEST_CASE("MultiStream")
+		{
+			String text;
+			for(auto& s : stringVector) {
+				text += s;
+			}
+			FSTR::MultiStream stream(stringVector);
+			REQUIRE(stream.isValid());
+			REQUIRE_EQ(stream.getFragmentCount(), stringVector.length());
+			REQUIRE_EQ(stream.available(), int(text.length()));
+			for(auto chunkSize : {1, 3, 100}) {
+				REQUIRE_EQ(stream.seekFrom(0, SeekOrigin::Start), 0);
+				REQUIRE(readStream(stream, chunkSize) == text);
+			}
+
+			// Random seek
+			char buffer[16];
+			for(unsigned pos = 0; pos < text.length(); pos += 5) {
+				REQUIRE_EQ(stream.seekFrom(pos, SeekOrigin::Start), int(pos));
+				auto n = stream.readMemoryBlock(buffer, sizeof(buffer));
+				REQUIRE_EQ(n, std::min(sizeof(buffer), text.length() - pos));
+				REQUIRE(memcmp(buffer, text.c_str() + pos, n) == 0);
+			}
+			REQUIRE(stream.seekFrom(1, SeekOrigin::End) < 0);
+
+			// Empty and null fragments
+			DEFINE_FSTR_LOCAL(header, "<header>");
+			DEFINE_FSTR_LOCAL(footer, "<footer>");
+			FSTR::MultiStream stream2({&header, &FSTR::String::empty(), nullptr, &licenseText, &footer});
+			REQUIRE_EQ(stream2.getFragmentCount(), 5U);
+			REQUIRE_EQ(stream2.findFragment(8), 3U);
+			auto s = readStream(stream2, 200);
+			REQUIRE(s == String(header) + String(licenseText) + String(footer));
+		}
+
+		TEST_CASE("RangeStream")
+		{
+			String text(licenseText);
+			FSTR::RangeStream stream(licenseText, 1000, 500);
+			REQUIRE_EQ(stream.available(), 500);
+			auto s = readStream(stream, 64);
+			REQUIRE(stream.isFinished());
+			REQUIRE_EQ(stream.available(), 0);
+			REQUIRE(s == text.substring(1000, 1500));
+
+			REQUIRE_EQ(stream.seekFrom(-10, SeekOrigin::End), 490);
+			REQUIRE_EQ(stream.available(), 10);
+			REQUIRE(stream.seekFrom(1, SeekOrigin::End) < 0);
+
+			// Truncated to object length
+			FSTR::RangeStream stream2(licenseText, text.length() - 20, 100);
+			REQUIRE_EQ(stream2.getRange().length, 20U);
+			REQUIRE(readStream(stream2, 7) == text.substring(text.length() - 20));
+		}
+
+		TEST_CASE("MultipartRangeStream")
+		{
+			String text(licenseText);
+			// Empty ranges, including those beyond the end of the object, are skipped
+			FSTR::MultipartRangeStream stream(licenseText, {{0, 10}, {50, 0}, {100, 20}, {8000, 10}}, "text/plain",
+											  "BOUNDARY");
+			REQUIRE(stream.isValid());
+			String expected;
+			expected += "--BOUNDARY\r\nContent-Type: text/plain\r\nContent-Range: bytes 0-9/7633\r\n\r\n";
+			expected += text.substring(0, 10);
+			expected += "\r\n--BOUNDARY\r\nContent-Type: text/plain\r\nContent-Range: bytes 100-119/7633\r\n\r\n";
+			expected += text.substring(100, 120);
+			expected += "\r\n--BOUNDARY--\r\n";
+			REQUIRE_EQ(stream.available(), int(expected.length()));
+			for(auto chunkSize : {1, 5, 256}) {
+				REQUIRE_EQ(stream.seekFrom(0, SeekOrigin::Start), 0);
+				auto s = readStream(stream, chunkSize);
+				REQUIRE(s == expected);
+			}
+
+			char buffer[16];
+			REQUIRE_EQ(stream.seekFrom(-20, SeekOrigin::End), int(expected.length()) - 20);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, expected.c_str() + expected.length() - 20, sizeof(buffer)) == 0);
+
+			FSTR::MultipartRangeStream empty(licenseText, {{10, 0}}, "text/plain", "BOUNDARY");
+			REQUIRE(!empty.isValid());
+		}
+
+		TEST_CASE("Compiled template")
+		{
+			REQUIRE_EQ(pageTemplate.variables().length(), 4U);
+			REQUIRE_EQ(pageTemplate.fields().length(), 5U);
+
+			FSTR::CompiledTemplateStream stream(pageTemplate);
+			REQUIRE(stream.isValid());
+			REQUIRE_EQ(stream.available(), int(pageTemplate.text().length()));
+			REQUIRE(stream.setVar("title", "Test Page"));
+			REQUIRE(stream.setVar("name", "Fred"));
+			REQUIRE(stream.setVar("count", "12"));
+			REQUIRE(!stream.setVar("unknown", "value"));
+			REQUIRE(stream.getVar("name") == "Fred");
+
+			String expected = "<html>\n"
+							  "<head>\n"
+							  "<title>Test Page</title>\n"
+							  "<style>body { margin: 0; }</style>\n"
+							  "</head>\n"
+							  "<body>\n"
+							  "<h1>Test Page</h1>\n"
+							  "<p>Hello Fred, you have 12 new messages.</p>\n"
+							  "<p></p>\n"
+							  "</body>\n"
+							  "</html>\n";
+			REQUIRE_EQ(stream.available(), int(expected.length()));
+			for(auto chunkSize : {1, 5, 256}) {
+				REQUIRE_EQ(stream.seekFrom(0, SeekOrigin::Start), 0);
+				auto s = readStream(stream, chunkSize);
+				REQUIRE(s == expected);
+			}
+
+			char buffer[16];
+			REQUIRE_EQ(stream.seekFrom(95, SeekOrigin::Start), 95);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, expected.c_str() + 95, sizeof(buffer)) == 0);
+		}
+
+		TEST_CASE("PrintJob")
+		{
+			ThrottledPrint output;
+			FSTR::StringPrintJob job(output, licenseText);
+			REQUIRE(runPrintJob(job, output) == String(licenseText));
+			REQUIRE(runPrintJob<FSTR::ArrayPrintJob>(doubleArray) == printToString(doubleArray));
+			REQUIRE(runPrintJob<FSTR::ArrayPrintJob>(stringVector) == printToString(stringVector));
+			REQUIRE(runPrintJob<FSTR::MapPrintJob>(stringMap) == printToString(stringMap));
+			REQUIRE(runPrintJob<FSTR::MapPrintJob>(arrayMap) == printToString(arrayMap));
+		}
+
+		TEST_CASE("Buffered print")
+		{
+			CapturePrint capture;
+			{
+				FSTR::BufferedPrint<16> p(capture);
+				p.print("0123456789");
+				p.print(':');
+				REQUIRE_EQ(capture.writeCount, 0U);
+				p.print("abcdef");
+				REQUIRE_EQ(capture.writeCount, 1U);
+				REQUIRE(capture.content == "0123456789:abcde");
+				p.print(String(licenseText));
+				REQUIRE_EQ(capture.writeCount, 3U);
+				p.print('!');
+				REQUIRE_EQ(p.getWriteCount(), 5U);
+				REQUIRE_EQ(p.getOutputCount(), 3U);
+			}
+			REQUIRE_EQ(capture.writeCount, 4U);
+			String expected = "0123456789:abcdef";
+			expected += licenseText;
+			expected += '!';
+			REQUIRE(capture.content == expected);
+
+			CapturePrint output;
+			auto count = largeIntArray.printTo(output);
+			Serial << _F("largeIntArray printed ") << count << _F(" bytes in ") << output.writeCount << _F(" writes")
+				   << endl;
+			REQUIRE_EQ(output.content.length(), count);
+			REQUIRE(output.writeCount <= 1 + count / FSTR_PRINT_BUFFER_SIZE);
+
+			// Output which accepts only part of the data: stop at first failure and report what was written
+			ThrottledPrint throttled;
+			count = largeIntArray.printTo(throttled);
+			REQUIRE_EQ(count, 11U);
+			REQUIRE_EQ(throttled.content.length(), count);
+			REQUIRE_EQ(throttled.writeCount, 1U);
+
+			ThrottledPrint throttledMap;
+			count = arrayMap.printTo(throttledMap);
+			REQUIRE_EQ(count, throttledMap.content.length());
+			REQUIRE_EQ(throttledMap.writeCount, 1U);
+		}
+
+		TEST_CASE("JSON")
+		{
+			REQUIRE(printToString(FSTR::JsonPrinter(stringVector)) ==
+					"[\"Test string #1\",null,\"Test string #2\"]");
+			REQUIRE(printToString(FSTR::JsonPrinter(arrayMap)) == "{\"1\":[1,2,3],\"2\":[4,5,6,7,8,9,10]}");
+			REQUIRE(printToString(FSTR::JsonPrinter(tableArray)) == "[[1,2,3],[4,5,6],[7,8,9]]");
+			REQUIRE(printToString(FSTR::JsonPrinter(doubleArray)) == "[3.141592653589793,53,100,100000000,47]");
+
+			DEFINE_FSTR_ARRAY_LOCAL(largeReals, double, 1e20, -1.5e-300, 4294967296.5, 0.1,
+									std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN());
+			REQUIRE(printToString(FSTR::JsonPrinter(largeReals)) ==
+					"[1e+20,-1.5e-300,4294967296.5,0.1,null,null]");
+			DEFINE_FSTR_ARRAY_LOCAL(floats, float, 0.1, 1.5, 3e10);
+			REQUIRE(printToString(FSTR::JsonPrinter(floats)) == "[0.1,1.5,3e+10]");
+
+			DEFINE_FSTR_LOCAL(content1Json, "\"This is content from file \\\"content1.txt\\\".\"");
+			DEFINE_FSTR_LOCAL(content2Json, "\"This is content from file \\\"content2.txt\\\".\"");
+			String expected = "{\"key1\":";
+			expected += content1Json;
+			expected += ",\"key2\":";
+			expected += content2Json;
+			expected += '}';
+			REQUIRE(printToString(FSTR::JsonPrinter(stringMap)) == expected);
+			REQUIRE(printToString(FSTR::JsonPrinter(inlineStringMap)) == expected);
+
+			expected = "{\"10\":";
+			expected += content1Json;
+			expected += ",\"20\":";
+			expected += content2Json;
+			expected += '}';
+			REQUIRE(printToString(FSTR::JsonPrinter(enumMap)) == expected);
+			REQUIRE(printToString(FSTR::JsonPrinter(columnarEnumMap)) == expected);
+
+			DEFINE_FSTR_LOCAL(controlText, "tab\there\r\n\x01\\");
+			REQUIRE(printToString(FSTR::JsonPrinter(controlText)) == "\"tab\\there\\r\\n\\u0001\\\\\"");
+
+			REQUIRE(printToString(FSTR::JsonPrinter(vectorMap)) ==
+					"{\"key1\":[\"Test string #1\",null,\"Test string #2\"]}");
+		}
+
+		TEST_CASE("JsonStream")
+		{
+			FSTR::JsonPrinter printer(largeStringMap);
+			auto expected = printToString(printer);
+			REQUIRE_EQ(printer.length(), expected.length());
+
+			FSTR::JsonStream stream(largeStringMap);
+			REQUIRE_EQ(size_t(stream.available()), expected.length());
+			String output;
+			char buffer[100];
+			size_t n;
+			while((n = stream.readBytes(buffer, sizeof(buffer))) != 0) {
+				output += String(buffer, n);
+			}
+			REQUIRE(stream.isFinished());
+			REQUIRE(output == expected);
+
+			REQUIRE_EQ(stream.seekFrom(1234, SeekOrigin::Start), 1234);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, expected.c_str() + 1234, sizeof(buffer)) == 0);
+		}
+
+		TEST_CASE("CBOR/MessagePack")
+		{
+			auto encode = [](const auto& object, FSTR::BinaryFormat format) -> String {
+				FSTR::BinaryStream stream(object, format);
+				String output;
+				char buffer[32];
+				size_t n;
+				while((n = stream.readBytes(buffer, sizeof(buffer))) != 0) {
+					output += String(buffer, n);
+				}
+				return output;
+			};
+
+			auto check = [](const String& output, const void* expected, size_t length) -> bool {
+				return output.length() == length && memcmp(output.c_str(), expected, length) == 0;
+			};
+
+			// Vector of strings including a null entry
+			const uint8_t cborVector[]{
+				0x83, 0x6e, 'T',  'e', 's', 't', ' ', 's', 't', 'r', 'i', 'n', 'g', ' ', '#', '1', //
+				0xf6, 0x6e, 'T',  'e', 's', 't', ' ', 's', 't', 'r', 'i', 'n', 'g', ' ', '#', '2', //
+			};
+			auto output = encode(stringVector, FSTR::BinaryFormat::CBOR);
+			REQUIRE(check(output, cborVector, sizeof(cborVector)));
+
+			const uint8_t msgPackVector[]{
+				0x93, 0xae, 'T',  'e', 's', 't', ' ', 's', 't', 'r', 'i', 'n', 'g', ' ', '#', '1', //
+				0xc0, 0xae, 'T',  'e', 's', 't', ' ', 's', 't', 'r', 'i', 'n', 'g', ' ', '#', '2', //
+			};
+			output = encode(stringVector, FSTR::BinaryFormat::MessagePack);
+			REQUIRE(check(output, msgPackVector, sizeof(msgPackVector)));
+
+			// Array elements exactly representable in single precision
+			const uint8_t cborTable[]{
+				0x83,																	 //
+				0x83, 0xfa, 0x3f, 0x80, 0, 0, 0xfa, 0x40, 0x00, 0, 0, 0xfa, 0x40, 0x40, 0, 0, //
+				0x83, 0xfa, 0x40, 0x80, 0, 0, 0xfa, 0x40, 0xa0, 0, 0, 0xfa, 0x40, 0xc0, 0, 0, //
+				0x83, 0xfa, 0x40, 0xe0, 0, 0, 0xfa, 0x41, 0x00, 0, 0, 0xfa, 0x41, 0x10, 0, 0, //
+			};
+			output = encode(tableArray, FSTR::BinaryFormat::CBOR);
+			REQUIRE(check(output, cborTable, sizeof(cborTable)));
+
+			// Numeric arrays are copied directly as tagged byte strings
+			const float row1[]{1, 2, 3};
+			const float row2[]{4, 5, 6, 7, 8, 9, 10};
+			String expected;
+			expected += char(0xa2);
+			expected += char(0x01);
+			expected += String("\xd8\x55\x4c", 3);
+			expected += String(reinterpret_cast<const char*>(row1), sizeof(row1));
+			expected += char(0x02);
+			expected += String("\xd8\x55\x58\x1c", 4);
+			expected += String(reinterpret_cast<const char*>(row2), sizeof(row2));
+			output = encode(arrayMap, FSTR::BinaryFormat::CBOR);
+			REQUIRE(output == expected);
+
+			output = encode(doubleArray, FSTR::BinaryFormat::MessagePack);
+			REQUIRE_EQ(output.length(), 2 + doubleArray.size());
+			REQUIRE(memcmp(output.c_str(), "\xc4\x28", 2) == 0);
+			REQUIRE(memcmp(output.c_str() + 2, doubleArray.data(), doubleArray.size()) == 0);
+
+			// Integer keys
+			output = encode(enumMap, FSTR::BinaryFormat::MessagePack);
+			REQUIRE(memcmp(output.c_str(), "\x82\x0a\xd9\x29This", 7) == 0);
+
+			// Stream length and seeking
+			output = encode(largeStringMap, FSTR::BinaryFormat::CBOR);
+			FSTR::BinaryStream stream(largeStringMap, FSTR::BinaryFormat::CBOR);
+			REQUIRE_EQ(size_t(stream.available()), output.length());
+			char buffer[100];
+			REQUIRE_EQ(stream.seekFrom(1234, SeekOrigin::Start), 1234);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, output.c_str() + 1234, sizeof(buffer)) == 0);
+		}
+
+		TEST_CASE("CSV")
+		{
+			REQUIRE(printToString(FSTR::CsvPrinter<TableRow_Float_3>(tableArray)) ==
+					"1.00,2.00,3.00\r\n4.00,5.00,6.00\r\n7.00,8.00,9.00\r\n");
+
+			FSTR::PrintFormat integer;
+			integer.precision = 0;
+			FSTR::PrintFormat padded;
+			padded.precision = 1;
+			padded.width = 5;
+			const FSTR::CsvColumn columns[]{{"x", integer}, {nullptr, integer}, {"z", padded}};
+			REQUIRE(printToString(FSTR::CsvPrinter<TableRow_Float_3>(tableArray, columns, ARRAY_SIZE(columns))) ==
+					"x,,z\r\n1,2,  3.0\r\n4,5,  6.0\r\n7,8,  9.0\r\n");
+
+			struct Reading {
+				uint32_t time;
+				int8_t temperature;
+			};
+			DEFINE_FSTR_ARRAY_LOCAL(readings, Reading, {1000, -5}, {2000, 12});
+			auto printReading = [](Print& p, const Reading& row, unsigned column,
+								   const FSTR::PrintFormat& format) -> size_t {
+				return (column == 0) ? printElement(p, row.time, format) : printElement(p, row.temperature, format);
+			};
+			const FSTR::CsvColumn readingColumns[]{{"time"}, {"temperature"}};
+			FSTR::CsvPrinter<Reading> printer(readings, readingColumns, ARRAY_SIZE(readingColumns), printReading);
+			printer.setDelimiter(';');
+			REQUIRE(printToString(printer) == "time;temperature\r\n1000;-5\r\n2000;12\r\n");
+		}
+
+		TEST_CASE("CsvStream")
+		{
+			const FSTR::CsvColumn columns[]{{"a"}, {"b"}, {"c"}};
+			auto expected = printToString(FSTR::CsvPrinter<TableRow_Float_3>(tableArray, columns, 3));
+
+			FSTR::CsvStream<TableRow_Float_3> stream(tableArray, columns, 3);
+			REQUIRE_EQ(size_t(stream.available()), expected.length());
+			String output;
+			char buffer[7];
+			size_t n;
+			while((n = stream.readBytes(buffer, sizeof(buffer))) != 0) {
+				output += String(buffer, n);
+			}
+			REQUIRE(stream.isFinished());
+			REQUIRE(output == expected);
+
+			REQUIRE_EQ(stream.seekFrom(10, SeekOrigin::Start), 10);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, expected.c_str() + 10, sizeof(buffer)) == 0);
+		}
+
+		TEST_CASE("Buffered stream")
+		{
+			String text(licenseText);
+			for(auto chunkSize : {1, 7, 100, 256}) {
+				FSTR::BufferedStream stream(licenseText, 128);
+				REQUIRE(stream.isValid());
+				REQUIRE_EQ(stream.getBlockSize(), 64U);
+				REQUIRE_EQ(stream.available(), int(text.length()));
+				auto s = readStream(stream, chunkSize);
+				REQUIRE(s == text);
+				Serial << _F("Chunk size ") << chunkSize << _F(", ") << stream.getReadCount() << _F(" flash reads")
+					   << endl;
+			}
+
+			FSTR::BufferedStream stream(licenseText, 128);
+			char buffer[32];
+
+			// Peek spanning a block boundary then consume
+			REQUIRE_EQ(stream.seekFrom(50, SeekOrigin::Start), 50);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 50, sizeof(buffer)) == 0);
+			REQUIRE_EQ(stream.getReadCount(), 2U);
+			REQUIRE_EQ(stream.readBytes(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 50, sizeof(buffer)) == 0);
+
+			// Seeking within buffered data requires no further reads
+			REQUIRE_EQ(stream.seekFrom(-40, SeekOrigin::Current), 42);
+			REQUIRE_EQ(stream.readBytes(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 42, sizeof(buffer)) == 0);
+			REQUIRE_EQ(stream.getReadCount(), 2U);
+
+			REQUIRE_EQ(stream.seekFrom(-3, SeekOrigin::End), int(text.length() - 3));
+			REQUIRE_EQ(stream.readBytes(buffer, sizeof(buffer)), 3U);
+			REQUIRE(memcmp(buffer, text.c_str() + text.length() - 3, 3) == 0);
+			REQUIRE(stream.isFinished());
+			REQUIRE(stream.seekFrom(1, SeekOrigin::Current) < 0);
+		}
+
+		TEST_CASE("Gzip object")
+		{
+			REQUIRE(licenseGzip.isValid());
+			REQUIRE_EQ(licenseGzip.uncompressedLength(), licenseText.length());
+			REQUIRE_EQ(licenseGzip.windowBits(), 10);
+			REQUIRE(licenseGzip32K.isValid());
+			REQUIRE_EQ(licenseGzip32K.uncompressedLength(), licenseText.length());
+			REQUIRE_EQ(licenseGzip32K.windowBits(), 15);
+			REQUIRE(!licenseText.as<FSTR::GzipObject>().isValid());
+			Serial << _F("LICENSE ") << licenseText.length() << _F(" bytes, compressed ") << licenseGzip.length()
+				   << endl;
+		}
+
+		TEST_CASE("Gzip passthrough")
+		{
+			std::unique_ptr<IDataSourceStream> stream(licenseGzip.createStream(true));
+			REQUIRE_EQ(stream->available(), int(licenseGzip.length()));
+			char buffer[16];
+			REQUIRE_EQ(stream->readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, "\x1f\x8b", 2) == 0);
+		}
+
+		TEST_CASE("Gzip inflate")
+		{
+			String text(licenseText);
+			for(auto& obj : {&licenseGzip, &licenseGzip32K}) {
+				for(auto chunkSize : {1, 7, 100, 256}) {
+					std::unique_ptr<IDataSourceStream> stream(obj->createStream(false));
+					REQUIRE(stream->isValid());
+					REQUIRE_EQ(stream->available(), int(text.length()));
+					auto s = readStream(*stream, chunkSize);
+					REQUIRE(stream->isValid());
+					REQUIRE_EQ(s.length(), text.length());
+					REQUIRE(s == text);
+				}
+			}
+		}
+
+		TEST_CASE("Gzip inflate seek")
+		{
+			String text(licenseText);
+			FSTR::InflateStream stream(licenseGzip);
+			char buffer[32];
+
+			// Forward
+			REQUIRE_EQ(stream.seekFrom(5000, SeekOrigin::Start), 5000);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 5000, sizeof(buffer)) == 0);
+
+			// Backward, within window
+			REQUIRE_EQ(stream.seekFrom(-100, SeekOrigin::Current), 4900);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 4900, sizeof(buffer)) == 0);
+
+			// Backward, requires restart
+			REQUIRE_EQ(stream.seekFrom(10, SeekOrigin::Start), 10);
+			REQUIRE_EQ(stream.readMemoryBlock(buffer, sizeof(buffer)), sizeof(buffer));
+			REQUIRE(memcmp(buffer, text.c_str() + 10, sizeof(buffer)) == 0);
+
+			REQUIRE_EQ(stream.seekFrom(-10, SeekOrigin::End), int(text.length() - 10));
+			REQUIRE_EQ(stream.readBytes(buffer, sizeof(buffer)), 10U);
+			REQUIRE(memcmp(buffer, text.c_str() + text.length() - 10, 10) == 0);
+			REQUIRE(stream.isFinished());
+			REQUIRE(stream.seekFrom(1, SeekOrigin::Current) < 0);
+		}
+	}
+};
+
+void REGISTER_TEST(stream)
+{
+	registerGroup<StreamTest>();
+}
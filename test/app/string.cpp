@@ -29,6 +29,9 @@ struct InClassTest {
 	DEFINE_FSTR_LOCAL(str1, "str1")
 	DEFINE_FSTR_LOCAL(str2, "str2")
 };
+
+// Digest generated using `tools/fstrdigest.py`
+IMPORT_FSTR_DIGEST_LOCAL(content1WithDigest, COMPONENT_PATH "/files/content1.txt")
 } // namespace
 
 class StringTest : public TestGroup
@@ -164,6 +167,26 @@ public:
 			REQUIRE_EQ(F("str1"), InClassTest::str1);
 			REQUIRE_EQ(F("str2"), InClassTest::str2);
 		}
+
+		TEST_CASE("Import with digest")
+		{
+			auto& content1 = stringMap["key1"].content();
+			REQUIRE(content1WithDigest.hasDigest());
+			REQUIRE(!content1.hasDigest());
+			REQUIRE(!empty.hasDigest());
+			REQUIRE_EQ(content1WithDigest.length(), content1.length());
+			REQUIRE(content1WithDigest == content1);
+
+			FSTR::ObjectDigest digest;
+			REQUIRE(!content1.digest(digest));
+			REQUIRE(content1WithDigest.digest(digest));
+			REQUIRE_EQ(digest.crc32, 0x8ab3d18eU);
+			REQUIRE_EQ(digest.sha256[0], 0xdb);
+			REQUIRE_EQ(digest.sha256[31], 0x46);
+			REQUIRE_EQ(content1.crc32(), digest.crc32);
+			REQUIRE(content1WithDigest.verify());
+			REQUIRE(!content1.verify());
+		}
 	}
 };
 
@@ -96,6 +96,51 @@ public:
 				REQUIRE_EQ(String::nullstr, InClassTest::localData[5]);
 			}
 		}
+
+		TEST_CASE("FrontCodedStringSet")
+		{
+			Serial << pathSet << endl;
+			Serial << _F("pathSet[") << pathSet.length() << _F("], ") << pathSet.blockCount() << _F(" blocks, ")
+				   << pathSet.size() << _F(" bytes") << endl;
+
+			// Duplicate entry removed
+			REQUIRE_EQ(pathSet.length(), 18U);
+
+			TEST_CASE("iterator")
+			{
+				String prev;
+				unsigned i{0};
+				for(auto it = pathSet.begin(); it != pathSet.end(); ++it, ++i) {
+					String s(*it);
+					REQUIRE_EQ(s.length(), it.length());
+					REQUIRE(i == 0 || strcmp(prev.c_str(), *it) < 0);
+					REQUIRE_EQ(pathSet.indexOf(*it), int(i));
+					char buf[FSTR::FrontCodedStringSet::maxKeyLength + 1];
+					REQUIRE_EQ(pathSet.valueAt(i, buf), s.length());
+					REQUIRE(s == buf);
+					prev = s;
+				}
+				REQUIRE_EQ(i, pathSet.length());
+			}
+
+			TEST_CASE("lookup")
+			{
+				REQUIRE(pathSet.contains("wifi.sta.ssid"));
+				REQUIRE(pathSet.contains(F("/www/img/icons/mqtt.svg")));
+				REQUIRE(!pathSet.contains("wifi.sta"));
+				REQUIRE(!pathSet.contains("WIFI.STA.SSID"));
+				REQUIRE(!pathSet.contains(""));
+				REQUIRE(!pathSet.contains("zzz"));
+			}
+
+			TEST_CASE("local")
+			{
+				DEFINE_FSTR_FRONT_CODED_SET_LOCAL(fruit, "pear", "apple", "apricot", "apple");
+				REQUIRE_EQ(fruit.length(), 3U);
+				REQUIRE_EQ(fruit.indexOf("apricot"), 1);
+				REQUIRE(!fruit.contains("banana"));
+			}
+		}
 	}
 };
 
@@ -4,6 +4,23 @@ COMPONENT_DEPENDS := \
 	SmingTest \
 	FlashString
 
+# Digest files for IMPORT_FSTR_DIGEST tests
+DIGEST_FILES := $(COMPONENT_PATH)/files/content1.txt
+COMPONENT_PREREQUISITES := $(DIGEST_FILES:=.digest)
+FSTR_DIGEST_TOOL := $(COMPONENT_PATH)/../tools/fstrdigest.py
+
+%.digest: %
+	$(Q) python3 $(FSTR_DIGEST_TOOL) $<
+
+# Compare FileMap speed with SPIFFS and LittleFS, using images built from the same files
+CONFIG_VARS += ENABLE_FS_BENCHMARK
+ENABLE_FS_BENCHMARK ?= 0
+ifeq ($(ENABLE_FS_BENCHMARK),1)
+COMPONENT_DEPENDS += Spiffs LittleFS
+HWCONFIG := fs-benchmark
+APP_CFLAGS += -DENABLE_FS_BENCHMARK
+endif
+
 # Don't need network
 HOST_NETWORK_OPTIONS := --nonet
 DISABLE_NETWORK := 1
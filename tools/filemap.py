@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# filemap.py - Generate a FlashString FileMap from a directory tree
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Example:
+#
+#   filemap.py --name webFiles --base-var PROJECT_DIR --base-path web web/www > src/webfiles.cpp
+#
+# Each file is imported using IMPORT_FSTR_LOCAL, and a File object created containing its MIME type,
+# modification time and entity tag. These are then listed in a FileMap, keyed by path relative to the
+# source directory.
+#
+
+import argparse
+import mimetypes
+import os
+import sys
+
+
+def fnv1a(data):
+    """Same as FSTR::ObjectBase::hash()"""
+    value = 2166136261
+    for c in data:
+        value = ((value ^ c) * 16777619) & 0xffffffff
+    return value
+
+
+def cstr(s):
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def scan(root):
+    files = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        for name in sorted(filenames):
+            path = os.path.join(dirpath, name)
+            files.append((os.path.relpath(path, root).replace(os.sep, '/'), path))
+    return files
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate FlashString FileMap source from a directory tree')
+    parser.add_argument('--name', default='fileMap', help='Name of FileMap object to define')
+    parser.add_argument('--local', action='store_true', help='Define FileMap using static linkage')
+    parser.add_argument('--base-var', help='Macro used to locate files, e.g. PROJECT_DIR or COMPONENT_PATH')
+    parser.add_argument('--base-path', help='Path corresponding to base variable')
+    parser.add_argument('--prefix', default='', help='Prefix to apply to paths in map')
+    parser.add_argument('source', help='Directory to import')
+    args = parser.parse_args()
+
+    base_path = os.path.abspath(args.base_path or os.getcwd())
+
+    def import_path(path):
+        if not args.base_var:
+            return cstr(os.path.abspath(path).replace(os.sep, '/'))
+        rel = os.path.relpath(os.path.abspath(path), base_path).replace(os.sep, '/')
+        return '%s %s' % (args.base_var, cstr('/' + rel))
+
+    files = scan(args.source)
+    mime_types = {}
+    out = sys.stdout
+
+    out.write('/*\n * Generated by filemap.py from "%s"\n */\n\n' % args.source.replace(os.sep, '/'))
+    out.write('#include <FlashString/FileMap.hpp>\n\n')
+
+    for i, (rel, path) in enumerate(files):
+        mime = mimetypes.guess_type(rel)[0] or 'application/octet-stream'
+        if mime not in mime_types:
+            mime_types[mime] = '%s_mime%u' % (args.name, len(mime_types))
+            out.write('DEFINE_FSTR_LOCAL(%s, %s)\n' % (mime_types[mime], cstr(mime)))
+
+    out.write('\n')
+    for i, (rel, path) in enumerate(files):
+        with open(path, 'rb') as f:
+            etag = fnv1a(f.read())
+        mime = mimetypes.guess_type(rel)[0] or 'application/octet-stream'
+        mtime = int(os.path.getmtime(path))
+        data = '%s_data%u' % (args.name, i)
+        out.write('IMPORT_FSTR_LOCAL(%s, %s)\n' % (data, import_path(path)))
+        out.write('DEFINE_FSTR_FILE_LOCAL(%s_file%u, %s, %s, %u, 0x%08x)\n'
+                  % (args.name, i, data, mime_types[mime], mtime, etag))
+
+    out.write('\n')
+    out.write('DEFINE_FSTR_FILE_MAP%s(%s,\n' % ('_LOCAL' if args.local else '', args.name))
+    out.write(',\n'.join('\t{%s, &%s_file%u}' % (cstr(args.prefix + rel), args.name, i)
+                          for i, (rel, path) in enumerate(files)))
+    out.write(');\n')
+
+
+if __name__ == '__main__':
+    main()
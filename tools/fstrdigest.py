@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#
+# fstrdigest.py - Generate digest files for use with IMPORT_FSTR_OBJECT_DIGEST
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# For each input file a sidecar file is written with `.digest` appended to the name.
+# This contains the FSTR::ObjectDigest structure: CRC32 (little-endian) followed by SHA-256.
+#
+# Files are only re-written if content has changed, so this may be run on every build.
+#
+
+import argparse
+import hashlib
+import struct
+import zlib
+
+
+def digest(data):
+    return struct.pack('<I', zlib.crc32(data) & 0xffffffff) + hashlib.sha256(data).digest()
+
+
+def update(filename):
+    with open(filename, 'rb') as f:
+        value = digest(f.read())
+    digest_filename = filename + '.digest'
+    try:
+        with open(digest_filename, 'rb') as f:
+            if f.read() == value:
+                return False
+    except FileNotFoundError:
+        pass
+    with open(digest_filename, 'wb') as f:
+        f.write(value)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate FlashString object digest files')
+    parser.add_argument('--verbose', '-v', action='store_true', help='List files updated')
+    parser.add_argument('files', nargs='+', help='Files to process')
+    args = parser.parse_args()
+
+    for filename in args.files:
+        if update(filename) and args.verbose:
+            print('Updated ' + filename + '.digest')
+
+
+if __name__ == '__main__':
+    main()
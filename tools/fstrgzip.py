@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+# fstrgzip.py - Compress a file for use with IMPORT_FSTR_GZIP
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Output is a standard gzip file, so may be sent directly to clients with `Content-Encoding: gzip`.
+#
+# The size of the compression window may be reduced so that less RAM is required to decompress it.
+# The window size is recorded in an 'FW' extra field so FSTR::InflateStream can allocate a suitable buffer.
+#
+
+import argparse
+import os
+import struct
+import zlib
+
+
+def compress(data, window_bits, mtime):
+    c = zlib.compressobj(9, zlib.DEFLATED, -window_bits, 9)
+    payload = c.compress(data) + c.flush()
+    extra = b'FW' + struct.pack('<HB', 1, window_bits)
+    FEXTRA = 0x04
+    header = struct.pack('<BBBBIBB', 0x1f, 0x8b, 8, FEXTRA, mtime, 2, 255)
+    header += struct.pack('<H', len(extra)) + extra
+    trailer = struct.pack('<II', zlib.crc32(data) & 0xffffffff, len(data) & 0xffffffff)
+    return header + payload + trailer
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress a file for use with IMPORT_FSTR_GZIP')
+    parser.add_argument('--window-bits', type=int, default=15, choices=range(9, 16), metavar='[9-15]',
+                        help='Size of compression window as power of 2 (default 15, 32KB)')
+    parser.add_argument('input', help='File to compress')
+    parser.add_argument('output', help='Output file, typically with .gz extension')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    mtime = int(os.path.getmtime(args.input))
+    with open(args.output, 'wb') as f:
+        f.write(compress(data, args.window_bits, mtime))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+#
+# fstrtemplate.py - Compile a template for use with FSTR::CompiledTemplateStream
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Example:
+#
+#   fstrtemplate.py --name indexTemplate web/index.html > src/index-template.cpp
+#
+# Variable tags have the form {name}, as for Sming's TemplateStream. Braces not enclosing a
+# valid identifier are treated as text, so embedded CSS and javascript are unaffected.
+#
+# Output contains the template text with tags removed, a table of variable names and a
+# table of fields giving the location in the text where each variable is to be inserted.
+#
+
+import argparse
+import os
+import re
+import sys
+
+
+def cstr_lines(data):
+    """Encode bytes as C string literal, split after each newline"""
+    lines = []
+    s = ''
+    for i, c in enumerate(data):
+        if c == 0x5c:
+            s += '\\\\'
+        elif c == 0x22:
+            s += '\\"'
+        elif c == 0x0a:
+            s += '\\n'
+        elif c == 0x0d:
+            s += '\\r'
+        elif c == 0x09:
+            s += '\\t'
+        elif c < 0x20 or c >= 0x7f:
+            s += '\\%03o' % c
+        else:
+            s += chr(c)
+        if c == 0x0a or i == len(data) - 1:
+            lines.append('"%s"' % s)
+            s = ''
+    return lines or ['""']
+
+
+def compile_template(data, open_tag, close_tag):
+    pattern = re.compile(re.escape(open_tag) + rb'([A-Za-z_][A-Za-z0-9_]*)' + re.escape(close_tag))
+    text = b''
+    variables = []
+    fields = []
+    pos = 0
+    for m in pattern.finditer(data):
+        text += data[pos:m.start()]
+        name = m.group(1).decode()
+        if name not in variables:
+            variables.append(name)
+        fields.append((len(text), variables.index(name)))
+        pos = m.end()
+    text += data[pos:]
+    return text, variables, fields
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile a template into FlashString objects')
+    parser.add_argument('--name', required=True, help='Name of CompiledTemplate object to define')
+    parser.add_argument('--local', action='store_true', help='Define template using static linkage')
+    parser.add_argument('--open-tag', default='{', help='Characters which start a variable tag')
+    parser.add_argument('--close-tag', default='}', help='Characters which end a variable tag')
+    parser.add_argument('source', help='Template file')
+    args = parser.parse_args()
+
+    with open(args.source, 'rb') as f:
+        data = f.read()
+    text, variables, fields = compile_template(data, args.open_tag.encode(), args.close_tag.encode())
+    if not variables:
+        sys.exit('No variables found in "%s", use IMPORT_FSTR instead' % args.source)
+
+    out = sys.stdout
+    name = args.name
+    out.write('/*\n * Generated by fstrtemplate.py from "%s"\n */\n\n' % args.source.replace(os.sep, '/'))
+    out.write('#include <FlashString/CompiledTemplate.hpp>\n\n')
+
+    out.write('DEFINE_FSTR_LOCAL(%s_text,\n\t\t\t\t  ' % name)
+    out.write('\n\t\t\t\t  '.join(cstr_lines(text)))
+    out.write(')\n\n')
+
+    for i, var in enumerate(variables):
+        out.write('DEFINE_FSTR_LOCAL(%s_var%u, "%s")\n' % (name, i, var))
+    out.write('DEFINE_FSTR_VECTOR_LOCAL(%s_variables, FSTR::String,\n' % name)
+    out.write(',\n'.join('\t&%s_var%u' % (name, i) for i in range(len(variables))))
+    out.write(')\n\n')
+
+    out.write('DEFINE_FSTR_ARRAY_LOCAL(%s_fields, FSTR::TemplateField,\n' % name)
+    out.write(',\n'.join('\t{%u, %u}' % field for field in fields))
+    out.write(')\n\n')
+
+    out.write('DEFINE_FSTR_TEMPLATE%s(%s, %s_text, %s_variables, %s_fields)\n'
+              % ('_LOCAL' if args.local else '', name, name, name, name))
+
+
+if __name__ == '__main__':
+    main()